@@ -0,0 +1,288 @@
+#ifndef LOUIERIKSSON_ARROW_HPP
+#define LOUIERIKSSON_ARROW_HPP
+
+#include "Conversions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/*
+ * The structures of the Arrow C Data Interface, as defined by its specification. They are ABI-stable, so they are
+ * defined here rather than depending upon an Arrow library; the guard is the one the specification prescribes, so
+ * that they are defined exactly once alongside other users of the interface.
+ *
+ * See: https://arrow.apache.org/docs/format/CDataInterface.html
+ */
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+	
+	struct ArrowSchema {
+		
+		const char* format;
+		const char* name;
+		const char* metadata;
+		int64_t flags;
+		int64_t n_children;
+		struct ArrowSchema** children;
+		struct ArrowSchema* dictionary;
+		
+		void (*release)(struct ArrowSchema*);
+		void* private_data;
+	};
+	
+	struct ArrowArray {
+		
+		int64_t length;
+		int64_t null_count;
+		int64_t offset;
+		int64_t n_buffers;
+		int64_t n_children;
+		const void** buffers;
+		struct ArrowArray** children;
+		struct ArrowArray* dictionary;
+		
+		void (*release)(struct ArrowArray*);
+		void* private_data;
+	};
+}
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @brief Contains conversions of floating-point Arrow arrays, exchanged through the Arrow C Data Interface.
+	 *
+	 * @details The unit of an array is read from the metadata of its field, and its values are converted directly
+	 * from (and optionally into) the buffers of the array, without copying them out. Null slots, as given by the
+	 * validity bitmap, are never read.
+	 *
+	 * Arrays of format "f" (float32) and "g" (float64) are supported.
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * // A field with metadata { "unit": "km/h" }:
+	 * Arrow::Convert<Conversions::Speed>(schema, array, Conversions::Speed::MetreSecond, out.data());
+	 * @endcode
+	 */
+	struct Arrow final {
+	
+	public:
+		
+		/** @brief The metadata key which holds the unit of a field, unless another is given. */
+		inline static constexpr std::string_view s_UnitKey = "unit";
+		
+		/**
+		 * @brief Finds a value in the metadata of a field.
+		 *
+		 * @param[in] _schema The field.
+		 * @param[in] _key The key of the value.
+		 * @return The value if the key is present, otherwise an empty optional.
+		 */
+		[[nodiscard]] static std::optional<std::string_view> Metadata(const ArrowSchema& _schema, const std::string_view& _key) {
+			
+			if (_schema.metadata == nullptr) {
+				return std::nullopt;
+			}
+			
+			// int32 count, followed by count pairs of (int32 length, bytes), in native byte order.
+			const auto* p = _schema.metadata;
+			
+			const auto read_int32 = [&p]() {
+				
+				int32_t result{};
+				std::memcpy(&result, p, sizeof(result));
+				p += sizeof(result);
+				
+				return static_cast<size_t>(result);
+			};
+			
+			const auto read_string = [&p, &read_int32]() {
+				
+				const auto length = read_int32();
+				const std::string_view result(p, length);
+				p += length;
+				
+				return result;
+			};
+			
+			for (auto count = read_int32(); count > 0U; --count) {
+				
+				const auto key   = read_string();
+				const auto value = read_string();
+				
+				if (key == _key) {
+					return value;
+				}
+			}
+			
+			return std::nullopt;
+		}
+		
+		/**
+		 * @brief Resolves the unit of a field from its metadata.
+		 *
+		 * @param[in] _schema The field.
+		 * @param[in] _key The metadata key which holds the unit's symbol.
+		 * @return The unit of the field.
+		 *
+		 * @throw std::invalid_argument If the field has no unit, or the unit is not a unit of TDimension.
+		 */
+		template<typename TDimension>
+		[[nodiscard]] static typename TDimension::Unit Unit(const ArrowSchema& _schema, const std::string_view& _key = s_UnitKey) {
+			
+			const auto symbol = Metadata(_schema, _key);
+			
+			if (!symbol.has_value()) {
+				throw std::invalid_argument("Field has no \"" + std::string(_key) + "\" metadata.");
+			}
+			
+			const auto unit = TDimension::TryGuessUnit(std::string(symbol.value()));
+			
+			if (!unit.has_value()) {
+				throw std::invalid_argument("Unrecognised unit \"" + std::string(symbol.value()) + "\".");
+			}
+			
+			return unit.value();
+		}
+		
+		/**
+		 * @brief Converts the values of an array into a new buffer.
+		 *
+		 * @param[in] _schema The field of the array, holding its unit.
+		 * @param[in] _array The array.
+		 * @param[in] _to The unit to convert to.
+		 * @param[out] _out Destination for the converted values. Must hold _array.length values. Null slots are set to
+		 * quiet NaN, so the validity bitmap of the array also applies to _out.
+		 * @param[in] _key The metadata key which holds the unit's symbol.
+		 */
+		template<typename TDimension, typename T>
+		static void Convert(const ArrowSchema& _schema, const ArrowArray& _array, const typename TDimension::Unit& _to, T* _out, const std::string_view& _key = s_UnitKey) {
+			
+			static_assert(std::is_floating_point_v<T>, "Values must be converted into a floating-point type.");
+
+#if defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+			const Instrumentation::Scope scope(Instrumentation::Batch);
+			Instrumentation::Counters<TDimension>::CountBatch(static_cast<size_t>(_array.length));
+#endif
+			
+			const auto plan = Conversions::Plan::Make<TDimension>(Unit<TDimension>(_schema, _key), _to);
+			
+			Dispatch(_schema, _array, [&](const auto* _data) {
+				Apply(_array, plan, _data, _out);
+			});
+		}
+		
+		/**
+		 * @brief Converts the values of an array in place.
+		 *
+		 * @param[in] _schema The field of the array, holding its unit.
+		 * @param[in,out] _array The array. Its data buffer must not be shared with any other consumer.
+		 * @param[in] _to The unit to convert to.
+		 * @param[in] _key The metadata key which holds the unit's symbol.
+		 *
+		 * @note The metadata of _schema is not modified, and still describes the original unit.
+		 */
+		template<typename TDimension>
+		static void ConvertInPlace(const ArrowSchema& _schema, ArrowArray& _array, const typename TDimension::Unit& _to, const std::string_view& _key = s_UnitKey) {
+
+#if defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+			const Instrumentation::Scope scope(Instrumentation::Batch);
+			Instrumentation::Counters<TDimension>::CountBatch(static_cast<size_t>(_array.length));
+#endif
+			
+			const auto plan = Conversions::Plan::Make<TDimension>(Unit<TDimension>(_schema, _key), _to);
+			
+			Dispatch(_schema, _array, [&](const auto* _data) {
+				
+				using value_t = std::remove_cv_t<std::remove_pointer_t<decltype(_data)>>;
+				
+				auto* data = const_cast<value_t*>(_data);
+				
+				Apply(_array, plan, data, data + _array.offset);
+			});
+		}
+	
+	private:
+		
+		/* Invokes _function with a pointer to the data buffer of the array, of the type given by its format. */
+		template<typename TFunction>
+		static void Dispatch(const ArrowSchema& _schema, const ArrowArray& _array, const TFunction& _function) {
+			
+			if (_schema.format == nullptr || _array.n_buffers != 2 || _array.buffers == nullptr) {
+				throw std::invalid_argument("Array is not a primitive array.");
+			}
+			
+			const std::string_view format(_schema.format);
+			
+			if (format == "f") {
+				_function(static_cast<const float*>(_array.buffers[1]));
+			}
+			else if (format == "g") {
+				_function(static_cast<const double*>(_array.buffers[1]));
+			}
+			else {
+				throw std::invalid_argument("Unsupported format \"" + std::string(format) + "\"; expected \"f\" or \"g\".");
+			}
+		}
+		
+		/* Null slots are left untouched when converting in place, and set to NaN otherwise. */
+		template<typename TIn, typename TOut>
+		static void Apply(const ArrowArray& _array, const Conversions::Plan& _plan, const TIn* _data, TOut* _out) noexcept {
+			
+			const auto scale  = static_cast<TOut>(_plan.m_Scale);
+			const auto offset = _plan.Offset<TOut>();
+			
+			const auto  length   = static_cast<size_t>(_array.length);
+			const auto  first    = static_cast<size_t>(_array.offset);
+			const auto* data     = _data + first;
+			const auto* validity = static_cast<const uint8_t*>(_array.buffers[0]);
+			
+			if (validity == nullptr || _array.null_count == 0) {
+				
+				for (size_t i = 0U; i < length; ++i) {
+					
+					auto product = static_cast<TOut>(data[i]) * scale;
+					Conversions::Round(product);
+					
+					_out[i] = product + offset;
+				}
+			}
+			else {
+				
+				for (size_t i = 0U; i < length; ++i) {
+					
+					const auto bit = first + i;
+					
+					if (((validity[bit >> 3U] >> (bit & 7U)) & 1U) != 0U) {
+						
+						auto product = static_cast<TOut>(data[i]) * scale;
+						Conversions::Round(product);
+						
+						_out[i] = product + offset;
+					}
+					else if (static_cast<const void*>(_out) != static_cast<const void*>(data)) {
+						_out[i] = std::numeric_limits<TOut>::quiet_NaN();
+					}
+				}
+			}
+		}
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_ARROW_HPP
@@ -0,0 +1,409 @@
+#ifndef LOUIERIKSSON_COLUMNS_HPP
+#define LOUIERIKSSON_COLUMNS_HPP
+
+#include "Conversions.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#endif
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @class UnitDictionary
+	 * @brief Converts a value column whose units are given by a dictionary-encoded symbol column.
+	 *
+	 * @details Each entry of the dictionary is resolved through TDimension::TryGuessUnit once, when the
+	 * UnitDictionary is created, into the factor and offset which convert it into the target unit. The value column
+	 * is then converted by gathering the factor and offset of each row by its dictionary code, which is vectorised
+	 * with AVX2 where the target supports it.
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * // A dictionary of { "km/h", "mph", "kn" }, and one code per row indexing it:
+	 * const UnitDictionary<Conversions::Speed> dictionary(symbols, Conversions::Speed::MetreSecond);
+	 *
+	 * dictionary.Convert(values.data(), codes.data(), values.size(), out.data());
+	 * @endcode
+	 */
+	template<typename TDimension, typename T = double>
+	class UnitDictionary final {
+		
+		static_assert(std::is_floating_point_v<T>, "Values must be of a floating-point type.");
+	
+	public:
+		
+		using dimension_t = TDimension;
+		using value_t     = T;
+		using unit_t      = typename TDimension::Unit;
+		
+		/**
+		 * @brief Resolves every entry of a dictionary of unit symbols.
+		 *
+		 * @param[in] _symbols The dictionary.
+		 * @param[in] _to The unit to convert values to.
+		 */
+		UnitDictionary(const std::vector<std::string>& _symbols, const unit_t& _to) :
+			m_Linear(true)
+		{
+			m_Scales .reserve(_symbols.size());
+			m_Offsets.reserve(_symbols.size());
+			
+			for (const auto& symbol : _symbols) {
+				
+				if (const auto unit = TDimension::TryGuessUnit(symbol)) {
+					
+					const auto plan = Conversions::Plan::Make<TDimension>(unit.value(), _to);
+					
+					m_Scales .emplace_back(static_cast<T>(plan.m_Scale));
+					m_Offsets.emplace_back(plan.template Offset<T>());
+					
+					m_Linear &= plan.IsLinear();
+				}
+				else {
+					m_Scales .emplace_back(std::numeric_limits<T>::quiet_NaN());
+					m_Offsets.emplace_back(std::numeric_limits<T>::quiet_NaN());
+				}
+			}
+		}
+		
+		/** @brief Returns the number of entries in the dictionary. */
+		[[nodiscard]] size_t size() const noexcept { return m_Scales.size(); }
+		
+		/**
+		 * @brief Returns true if a dictionary entry was recognised as a unit of TDimension.
+		 *
+		 * @param[in] _code The index of the entry.
+		 */
+		[[nodiscard]] bool IsResolved(const size_t& _code) const {
+			return m_Scales.at(_code) == m_Scales.at(_code);
+		}
+		
+		/**
+		 * @brief Converts a value column into the target unit.
+		 *
+		 * @param[in] _values Pointer to the first value.
+		 * @param[in] _codes Pointer to the dictionary code of the first value. Every code must index the dictionary.
+		 * @param[in] _size The number of values (and codes).
+		 * @param[out] _out Destination for the converted values. May be the same as _values. Values whose symbol
+		 * was not recognised are set to NaN.
+		 */
+		template<typename TCode>
+		void Convert(const T* _values, const TCode* _codes, const size_t& _size, T* _out) const noexcept {
+			
+			static_assert(std::is_integral_v<TCode>, "Dictionary codes must be of an integral type.");
+
+#if defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+			const Instrumentation::Scope scope(Instrumentation::Batch);
+			Instrumentation::Counters<TDimension>::CountBatch(_size);
+#endif
+			
+			const auto* scales  = m_Scales.data();
+			const auto* offsets = m_Offsets.data();
+			
+			size_t i = 0U;
+
+#if defined(__AVX2__)
+			if constexpr (std::is_same_v<T, double> && sizeof(TCode) <= sizeof(int32_t)) {
+				
+				if (m_Linear) {
+					
+					for (; i + 4U <= _size; i += 4U) {
+						
+						const auto codes = LoadCodes(_codes + i);
+						const auto scale = Gather(scales, codes);
+						
+						_mm256_storeu_pd(_out + i, _mm256_mul_pd(_mm256_loadu_pd(_values + i), scale));
+					}
+				}
+				else {
+					
+					for (; i + 4U <= _size; i += 4U) {
+						
+						const auto codes  = LoadCodes(_codes + i);
+						const auto scale  = Gather(scales,  codes);
+						const auto offset = Gather(offsets, codes);
+						
+						auto product = _mm256_mul_pd(_mm256_loadu_pd(_values + i), scale);
+						Conversions::Round(product);
+						
+						_mm256_storeu_pd(_out + i, _mm256_add_pd(product, offset));
+					}
+				}
+			}
+#endif
+			
+			for (; i < _size; ++i) {
+				
+				const auto code = static_cast<size_t>(_codes[i]);
+				
+				auto product = _values[i] * scales[code];
+				Conversions::Round(product);
+				
+				_out[i] = product + offsets[code];
+			}
+		}
+	
+	private:
+		
+		/** @brief True if no entry has an offset, so that offsets need not be gathered. */
+		bool m_Linear;
+		
+		std::vector<T> m_Scales;
+		std::vector<T> m_Offsets;
+
+#if defined(__AVX2__)
+		/* The masked form, with every lane enabled, avoids reading an uninitialised source operand. */
+		[[nodiscard]] static __m256d Gather(const double* _base, const __m128i& _indices) noexcept {
+			return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), _base, _indices, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), sizeof(double));
+		}
+		
+		/* Widens four codes to 32-bit indices. */
+		template<typename TCode>
+		[[nodiscard]] static __m128i LoadCodes(const TCode* _codes) noexcept {
+			
+			if constexpr (sizeof(TCode) == 1U) {
+				
+				int32_t packed{};
+				std::memcpy(&packed, _codes, sizeof(packed));
+				
+				return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+			}
+			else if constexpr (sizeof(TCode) == 2U) {
+				return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(_codes)));
+			}
+			else {
+				return _mm_loadu_si128(reinterpret_cast<const __m128i*>(_codes));
+			}
+		}
+#endif
+	};
+	
+	/**
+	 * @class PackedUnitColumn
+	 * @brief A column of units of TDimension, stored as codes of Bits bits each.
+	 *
+	 * @details Codes are the values of TDimension::Unit, packed into a contiguous little-endian bit stream, so every
+	 * group of eight codes occupies exactly Bits bytes. By default Bits is the fewest which hold every unit of the
+	 * dimension: four for most dimensions, and five for the largest.
+	 *
+	 * Convert unpacks a group of eight codes from a single 64-bit load in the same loop which converts the values,
+	 * so unpacking costs a few shifts per group. With AVX2, the codes are unpacked with vector variable shifts and
+	 * used directly as gather indices.
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * PackedUnitColumn<Conversions::Pressure> units;
+	 *
+	 * units.Push(Conversions::Pressure::Hectopascal);
+	 * units.Push(Conversions::Pressure::PoundSquareInch);
+	 *
+	 * units.Convert(values.data(), Conversions::Pressure::Pascal, out.data());
+	 * @endcode
+	 */
+	template<typename TDimension, size_t Bits = (TDimension::s_Count <= 16U ? 4U : (TDimension::s_Count <= 32U ? 5U : 8U))>
+	class PackedUnitColumn final {
+		
+		static_assert(Bits >= 1U && Bits <= 8U, "Codes must be between 1 and 8 bits.");
+		static_assert(TDimension::s_Count <= (size_t(1U) << Bits), "Every unit of the dimension must fit into a code.");
+	
+	public:
+		
+		using dimension_t = TDimension;
+		using unit_t      = typename TDimension::Unit;
+		
+		/** @brief The number of bits in each code. */
+		static constexpr size_t s_Bits = Bits;
+		
+		PackedUnitColumn() :
+			m_Size(0U),
+			m_Bytes(s_Padding, 0U) {}
+		
+		/** @brief Returns the number of codes in the column. */
+		[[nodiscard]] size_t size() const noexcept { return m_Size; }
+		
+		/** @brief Returns the packed codes, of which there are ((size() * Bits) + 7) / 8 bytes. */
+		[[nodiscard]] const uint8_t* data() const noexcept { return m_Bytes.data(); }
+		
+		/** @brief Reserves storage for a number of codes. */
+		void reserve(const size_t& _size) {
+			m_Bytes.reserve(Bytes(_size) + s_Padding);
+		}
+		
+		/**
+		 * @brief Appends a unit to the column.
+		 *
+		 * @param[in] _unit The unit to append.
+		 */
+		void Push(const unit_t& _unit) {
+			
+			m_Bytes.resize(Bytes(m_Size + 1U) + s_Padding, 0U);
+			
+			Set(m_Size++, _unit);
+		}
+		
+		/**
+		 * @brief Replaces the unit at an index.
+		 *
+		 * @param[in] _index The index of the code. Must be less than size().
+		 * @param[in] _unit The new unit.
+		 */
+		void Set(const size_t& _index, const unit_t& _unit) noexcept {
+			
+			const auto bit   = _index * Bits;
+			const auto shift = bit & 7U;
+			
+			// A code spans at most two bytes.
+			auto pair = static_cast<uint16_t>(m_Bytes[bit >> 3U] | (m_Bytes[(bit >> 3U) + 1U] << 8U));
+			
+			pair = static_cast<uint16_t>((pair & ~(s_Mask << shift)) | (static_cast<uint16_t>(_unit) << shift));
+			
+			m_Bytes[ bit >> 3U       ] = static_cast<uint8_t>(pair);
+			m_Bytes[(bit >> 3U) + 1U] = static_cast<uint8_t>(pair >> 8U);
+		}
+		
+		/**
+		 * @brief Returns the unit at an index.
+		 *
+		 * @param[in] _index The index of the code. Must be less than size().
+		 */
+		[[nodiscard]] unit_t Get(const size_t& _index) const noexcept {
+			
+			const auto bit = _index * Bits;
+			
+			const auto pair = static_cast<uint16_t>(m_Bytes[bit >> 3U] | (m_Bytes[(bit >> 3U) + 1U] << 8U));
+			
+			return static_cast<unit_t>((pair >> (bit & 7U)) & s_Mask);
+		}
+		
+		/**
+		 * @brief Converts a value column, whose units are given by this column, into a target unit.
+		 *
+		 * @param[in] _values Pointer to the first value. There must be size() values.
+		 * @param[in] _to The unit to convert to.
+		 * @param[out] _out Destination for the converted values. May be the same as _values.
+		 */
+		template<typename T>
+		void Convert(const T* _values, const unit_t& _to, T* _out) const noexcept {
+			
+			static_assert(std::is_floating_point_v<T>, "Values must be of a floating-point type.");
+
+#if defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+			const Instrumentation::Scope scope(Instrumentation::Batch);
+			Instrumentation::Counters<TDimension>::CountBatch(m_Size);
+#endif
+			
+			// Codes which are not units convert to NaN.
+			std::array<T, size_t(1U) << Bits> scales, offsets;
+			scales .fill(std::numeric_limits<T>::quiet_NaN());
+			offsets.fill(std::numeric_limits<T>::quiet_NaN());
+			
+			for (size_t i = 0U; i < TDimension::s_Count; ++i) {
+				
+				const auto plan = Conversions::Plan::Make<TDimension>(static_cast<unit_t>(i), _to);
+				
+				scales [i] = static_cast<T>(plan.m_Scale);
+				offsets[i] = plan.template Offset<T>();
+			}
+			
+			const auto groups = m_Size / 8U;
+			
+			for (size_t group = 0U; group < groups; ++group) {
+				
+				const auto* values = _values + (group * 8U);
+				auto*       out    = _out    + (group * 8U);
+				
+				const auto codes = LoadGroup(group);
+
+#if defined(__AVX2__)
+				if constexpr (std::is_same_v<T, double>) {
+					
+					const auto broadcast = _mm256_set1_epi64x(static_cast<int64_t>(codes));
+					const auto mask      = _mm256_set1_epi64x(static_cast<int64_t>(s_Mask));
+					
+					const auto lo = _mm256_and_si256(_mm256_srlv_epi64(broadcast, _mm256_setr_epi64x(0 * Bits, 1 * Bits, 2 * Bits, 3 * Bits)), mask);
+					const auto hi = _mm256_and_si256(_mm256_srlv_epi64(broadcast, _mm256_setr_epi64x(4 * Bits, 5 * Bits, 6 * Bits, 7 * Bits)), mask);
+					
+					auto lo_product = _mm256_mul_pd(_mm256_loadu_pd(values),      Gather(scales.data(), lo));
+					auto hi_product = _mm256_mul_pd(_mm256_loadu_pd(values + 4U), Gather(scales.data(), hi));
+					Conversions::Round(lo_product);
+					Conversions::Round(hi_product);
+					
+					_mm256_storeu_pd(out,      _mm256_add_pd(lo_product, Gather(offsets.data(), lo)));
+					_mm256_storeu_pd(out + 4U, _mm256_add_pd(hi_product, Gather(offsets.data(), hi)));
+					
+					continue;
+				}
+#endif
+				
+				for (size_t k = 0U; k < 8U; ++k) {
+					
+					const auto code = static_cast<size_t>((codes >> (k * Bits)) & s_Mask);
+					
+					auto product = values[k] * scales[code];
+					Conversions::Round(product);
+					
+					out[k] = product + offsets[code];
+				}
+			}
+			
+			for (size_t i = groups * 8U; i < m_Size; ++i) {
+				
+				const auto code = static_cast<size_t>(Get(i));
+				
+				auto product = _values[i] * scales[code];
+				Conversions::Round(product);
+				
+				_out[i] = product + offsets[code];
+			}
+		}
+	
+	private:
+		
+		static constexpr uint16_t s_Mask = static_cast<uint16_t>((1U << Bits) - 1U);
+		
+		/* Trailing bytes which allow every group, and every code, to be read with a single unaligned load. */
+		static constexpr size_t s_Padding = 8U;
+		
+		size_t m_Size;
+		
+		std::vector<uint8_t> m_Bytes;
+		
+		[[nodiscard]] static constexpr size_t Bytes(const size_t& _size) noexcept {
+			return ((_size * Bits) + 7U) / 8U;
+		}
+		
+		/* Loads the eight codes of a group, which begins on a byte boundary. */
+		[[nodiscard]] uint64_t LoadGroup(const size_t& _group) const noexcept {
+			
+			uint64_t result{};
+			std::memcpy(&result, m_Bytes.data() + (_group * Bits), sizeof(result));
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+			result = __builtin_bswap64(result);
+#endif
+			
+			return result;
+		}
+
+#if defined(__AVX2__)
+		[[nodiscard]] static __m256d Gather(const double* _base, const __m256i& _indices) noexcept {
+			return _mm256_mask_i64gather_pd(_mm256_setzero_pd(), _base, _indices, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), sizeof(double));
+		}
+#endif
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_COLUMNS_HPP
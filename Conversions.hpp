@@ -4,22 +4,234 @@
 #include <Hashmap.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+	#include "Instrumentation.hpp"
+#endif
+
+#if defined(LOUIERIKSSON_MATHS_MISS_LOG)
+	#include "MissLog.hpp"
+#endif
 
 namespace LouiEriksson::Maths {
 	
+	struct Prefixes;
+	
+	/**
+	 * @brief Builds a dense table indexed by unit from a list of unit-value pairs, given in any order.
+	 *
+	 * @param[in] _items The unit-value pairs. Every unit of the enum must appear exactly once.
+	 * @return An array holding the value of each unit at the index of that unit.
+	 *
+	 * @note Evaluated as a constant expression, a missing or repeated unit fails to compile.
+	 */
+	template<typename TUnit, typename TValue, size_t N>
+	constexpr std::array<TValue, N> MakeUnitTable(const std::pair<TUnit, TValue> (&_items)[N]) {
+		
+		std::array<TValue, N> result{};
+		std::array<bool,   N> assigned{};
+		
+		for (const auto& item : _items) {
+			
+			const auto index = static_cast<size_t>(item.first);
+			
+			if (index >= N || assigned[index]) {
+				throw std::logic_error("Every unit must appear exactly once.");
+			}
+			
+			result[index]   = item.second;
+			assigned[index] = true;
+		}
+		
+		return result;
+	}
+	
 	/**
 	 * @mainpage Version 1.0.0
 	 *
 	 * @brief Contains conversion functions for various units of measurement.
+	 *
+	 * @details Defining LOUIERIKSSON_MATHS_REPRODUCIBLE selects a reproducibility mode, in which every conversion
+	 * produces bit-identical results whichever code path (scalar, SSE, AVX2 or AVX-512), host, or partitioning of
+	 * the work between threads computes it. In this mode:
+	 *
+	 * - Factors are held as double, as the precision of long double differs between platforms.
+	 * - A Plan is applied in the precision of the value, as the batch kernels apply it, rather than in that of
+	 *   conversion_scalar_t.
+	 * - Every product which is later added to is rounded before the addition (see Round), so that it is never
+	 *   contracted into a fused multiply-add.
+	 *
+	 * Results then depend only on the inputs, as every operation of a conversion is a single correctly rounded IEEE
+	 * operation applied in a fixed order. Compiling with -ffp-contract=off (or /fp:precise) extends the guarantee to
+	 * code outside of the conversion kernels.
 	 */
 	struct Conversions final {
 	
+#if defined(LOUIERIKSSON_MATHS_REPRODUCIBLE)
+		using conversion_scalar_t = double;
+#else
 		using conversion_scalar_t = long double;
+#endif
 	
 	public:
+		
+		/**
+		 * @brief Rounds a floating-point value or SIMD vector to its type, so that it cannot be contracted into a
+		 * fused multiply-add with a subsequent addition.
+		 *
+		 * @details Compilers contract `(a * b) + c` into a fused multiply-add where the target has one (GCC does by
+		 * default, including across intrinsics), which rounds once rather than twice. The same kernel then produces
+		 * different results when built for a target with FMA than for one without. This has an effect only in the
+		 * reproducibility mode, and costs nothing but the freedom to fuse the two operations.
+		 *
+		 * @param[in,out] _val The value to round.
+		 */
+		template<typename T>
+		static constexpr void Round([[maybe_unused]] T& _val) noexcept {
+
+#if defined(LOUIERIKSSON_MATHS_REPRODUCIBLE) && defined(__GNUC__) && (defined(__SSE2__) || defined(__aarch64__))
+			
+			// x87 long double has no fused multiply-add to contract into.
+			if constexpr (!std::is_same_v<T, long double>) {
+				
+				if (!__builtin_is_constant_evaluated()) {
+					Barrier(_val);
+				}
+			}
+#endif
+		}
 	
+		/**
+		 * @brief Returns the name of a dimension, such as "Pressure".
+		 *
+		 * @tparam TDimension The dimension, such as Conversions::Pressure.
+		 * @tparam LowerCase If true, the name is in lower case, such as "pressure", as for a metric label.
+		 * @return The name, as a string literal.
+		 */
+		template<typename TDimension, bool LowerCase = false>
+		[[nodiscard]] static constexpr const char* Name() noexcept {
+			
+			if      constexpr (std::is_same_v<TDimension, Speed>)       { return LowerCase ? "speed"       : "Speed";       }
+			else if constexpr (std::is_same_v<TDimension, Distance>)    { return LowerCase ? "distance"    : "Distance";    }
+			else if constexpr (std::is_same_v<TDimension, Rotation>)    { return LowerCase ? "rotation"    : "Rotation";    }
+			else if constexpr (std::is_same_v<TDimension, Time>)        { return LowerCase ? "time"        : "Time";        }
+			else if constexpr (std::is_same_v<TDimension, Temperature>) { return LowerCase ? "temperature" : "Temperature"; }
+			else if constexpr (std::is_same_v<TDimension, Pressure>)    { return LowerCase ? "pressure"    : "Pressure";    }
+			else if constexpr (std::is_same_v<TDimension, Mass>)        { return LowerCase ? "mass"        : "Mass";        }
+			else if constexpr (std::is_same_v<TDimension, Area>)        { return LowerCase ? "area"        : "Area";        }
+			else {
+				
+				static_assert(std::is_same_v<TDimension, Volume>, "Not a dimension of Conversions.");
+				
+				return LowerCase ? "volume" : "Volume";
+			}
+		}
+		
+		/**
+		 * @struct Plan
+		 * @brief A conversion between two units of the same dimension, resolved ahead of time.
+		 *
+		 * Stores the conversion as the affine map `(_val * m_Scale) + m_Offset`, so that the factor lookups are
+		 * paid once per pair of units rather than once per value.
+		 */
+		struct Plan final {
+			
+			// Integer literals, as GCC rejects a floating-point literal of another precision here in constant evaluation.
+			conversion_scalar_t m_Scale  { 1 };
+			conversion_scalar_t m_Offset { 0 };
+			
+			/**
+			 * @brief Resolves the conversion between two units of a dimension.
+			 *
+			 * @param[in] _from The unit to convert from.
+			 * @param[in] _to The unit to convert to.
+			 * @return A Plan which agrees with TDimension::Convert.
+			 *
+			 * @note Temperature clamps at absolute zero, so its plan is only valid for values above absolute zero.
+			 */
+			template<typename TDimension>
+			[[nodiscard]] static constexpr Plan Make(const typename TDimension::Unit& _from, const typename TDimension::Unit& _to) {
+				
+#if defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+				uint64_t begin = 0U;
+				
+				if (!__builtin_is_constant_evaluated()) {
+					Instrumentation::Counters<TDimension>::CountPlan();
+					begin = Instrumentation::Begin();
+				}
+#endif
+				
+				Plan result{};
+				
+				if constexpr (std::is_same_v<TDimension, Temperature>) {
+					
+					// Sample the affine map at two points which lie above absolute zero in every unit.
+					const auto lo = TDimension::Convert(1000.0, _from, _to);
+					const auto hi = TDimension::Convert(2000.0, _from, _to);
+					
+					result.m_Scale = (hi - lo) / 1000.0;
+					
+					auto product = result.m_Scale * 1000.0;
+					Round(product);
+					
+					result.m_Offset = lo - product;
+				}
+				else {
+					result.m_Scale = TDimension::Convert(1.0, _from, _to);
+				}
+
+#if defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+				if (begin != 0U) {
+					Instrumentation::End(Instrumentation::Plan, begin);
+				}
+#endif
+				
+				return result;
+			}
+			
+			/** @brief Returns true if the plan is a pure multiplication. */
+			[[nodiscard]] constexpr bool IsLinear() const noexcept { return m_Offset == 0.0; }
+			
+			/**
+			 * @brief Returns the offset in the precision of a value, for kernels which apply `(_val * scale) + offset`.
+			 *
+			 * @details The offset of a linear plan is returned as -0.0, which unlike 0.0 is an exact additive identity
+			 * (-0.0 + 0.0 is 0.0, whereas -0.0 + -0.0 is -0.0), so that adding it agrees bit for bit with a kernel which
+			 * only multiplies.
+			 */
+			template<typename T>
+			[[nodiscard]] constexpr T Offset() const noexcept { return IsLinear() ? static_cast<T>(-0.0) : static_cast<T>(m_Offset); }
+			
+			/**
+			 * @brief Applies the plan to a value.
+			 *
+			 * @param[in] _val The value to be converted.
+			 * @return The converted value.
+			 */
+			template<typename T>
+			[[nodiscard]] constexpr T operator()(const T& _val) const {
+				
+				static_assert(std::is_floating_point_v<T>, "Plans apply to floating-point values; an integer would truncate the result.");
+
+#if defined(LOUIERIKSSON_MATHS_REPRODUCIBLE)
+				
+				auto product = _val * static_cast<T>(m_Scale);
+				Round(product);
+				
+				return product + Offset<T>();
+#else
+				return static_cast<T>((_val * m_Scale) + m_Offset);
+#endif
+			}
+		};
+		
 		/**
 		 * @struct Volume
 		 * @brief Provides a utility for deducing and converting between various units of speed.
@@ -38,6 +250,9 @@ namespace LouiEriksson::Maths {
 				Lightspeed,
 			};
 			
+			/** @brief The number of units of speed. */
+			static constexpr size_t s_Count = Lightspeed + 1U;
+			
 			/**
 			 * @brief Tries to guess the Unit based on the provided symbol.
 			 *
@@ -45,7 +260,7 @@ namespace LouiEriksson::Maths {
 			 * @return An optional reference to the Unit enum value if a match is found, otherwise an empty optional reference.
 			 */
 			static Hashmap<std::string, Conversions::Speed::Unit>::optional_ref TryGuessUnit(const std::string& _symbol) {
-				return s_Lookup.Get(_symbol);
+				return Find<Speed>(_symbol);
 			}
 			
 			/**
@@ -57,7 +272,7 @@ namespace LouiEriksson::Maths {
 			 *
 			 * @return The converted value.
 			 */
-			[[nodiscard]] static conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
+			[[nodiscard]] static constexpr conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
 				return _val * (s_Conversion[_from] / s_Conversion[_to]);
 			}
 			
@@ -71,8 +286,17 @@ namespace LouiEriksson::Maths {
 			 */
 			static const std::string& Symbol(const Unit& _unit) { return s_Symbol[_unit]; }
 			
+			/**
+			 * @brief Get every symbol recognised by TryGuessUnit, paired with the Unit it maps to.
+			 *
+			 * @return A vector of symbol-Unit pairs.
+			 */
+			static std::vector<Hashmap<std::string, Unit>::KeyValuePair> Aliases() { return s_Lookup.GetAll(); }
+		
 		protected:
 			
+			friend Conversions;
+			
 			inline static const Hashmap<std::string, Unit> s_Lookup {
 				{ "k/h",   KilometreHour },
 				{ "km/h",  KilometreHour },
@@ -104,7 +328,7 @@ namespace LouiEriksson::Maths {
 			};
 			
 			/** @brief Conversions between common speed units and m/s. */
-			inline static const Hashmap<Unit, conversion_scalar_t> s_Conversion {
+			inline static constexpr auto s_Conversion = MakeUnitTable<Unit, conversion_scalar_t>({
 				{ KilometreHour, 0.2777778   },
 				{ FeetSecond,    0.3048      },
 				{ MileHour,      0.44704     },
@@ -112,7 +336,7 @@ namespace LouiEriksson::Maths {
 	            { MetreSecond,   1.0         },
 				{ Mach,          340.29      },
 				{ Lightspeed,    299792458.0 },
-			};
+			});
 		};
 		
 		/**
@@ -138,6 +362,9 @@ namespace LouiEriksson::Maths {
 				Parsec,
 			};
 			
+			/** @brief The number of units of distance. */
+			static constexpr size_t s_Count = Parsec + 1U;
+			
 			/**
 			 * @brief Tries to guess the Unit based on the provided symbol.
 			 *
@@ -145,7 +372,7 @@ namespace LouiEriksson::Maths {
 			 * @return An optional reference to the Unit enum value if a match is found, otherwise an empty optional reference.
 			 */
 			static Hashmap<std::string, Conversions::Distance::Unit>::optional_ref TryGuessUnit(const std::string& _symbol)  {
-				return s_Lookup.Get(_symbol);
+				return Find<Distance>(_symbol);
 			}
 		
 			/**
@@ -157,7 +384,7 @@ namespace LouiEriksson::Maths {
 			 *
 			 * @return The converted value.
 			 */
-			[[nodiscard]] static conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
+			[[nodiscard]] static constexpr conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
 				return _val * (s_Conversion[_from] / s_Conversion[_to]);
 			}
 
@@ -171,6 +398,13 @@ namespace LouiEriksson::Maths {
 			 */
 			static const std::string& Symbol(const Unit& _unit) { return s_Symbol[_unit]; }
 			
+			/**
+			 * @brief Get every symbol recognised by TryGuessUnit, paired with the Unit it maps to.
+			 *
+			 * @return A vector of symbol-Unit pairs.
+			 */
+			static std::vector<Hashmap<std::string, Unit>::KeyValuePair> Aliases() { return s_Lookup.GetAll(); }
+			
 			/**
 			 * @brief Convert arc-seconds to metres.
 			 *
@@ -208,6 +442,8 @@ namespace LouiEriksson::Maths {
 	  
 		private:
 			
+			friend Conversions;
+			
 			inline static const Hashmap<std::string, Unit> s_Lookup {
 	            { "mm",         Millimetre       },
 	            { "cm",         Centimetre       },
@@ -248,7 +484,7 @@ namespace LouiEriksson::Maths {
 			};
 			
 			/** @brief Conversions between common lateral distance units and metres. */
-			inline static const Hashmap<Unit, conversion_scalar_t> s_Conversion {
+			inline static constexpr auto s_Conversion = MakeUnitTable<Unit, conversion_scalar_t>({
 	            { Millimetre,                       0.001      },
 	            { Centimetre,                       0.01       },
 	            { Inch,                             0.0254     },
@@ -261,7 +497,7 @@ namespace LouiEriksson::Maths {
 				{ AstronomicalUnit,      149597870700.0        },
 	            { Lightyear,         9460730472580800.0        },
 	            { Parsec,           30856775810000000.0        },
-			};
+			});
 			
 		};
 		
@@ -280,6 +516,9 @@ namespace LouiEriksson::Maths {
 				Turn,
 			};
 			
+			/** @brief The number of units of rotation. */
+			static constexpr size_t s_Count = Turn + 1U;
+			
 			static constexpr conversion_scalar_t s_DegreesToRadians = M_PI / 180.0;
 			static constexpr conversion_scalar_t s_RadiansToDegrees = 180.0 / M_PI;
 			
@@ -290,7 +529,7 @@ namespace LouiEriksson::Maths {
 			 * @return An optional reference to the Unit enum value if a match is found, otherwise an empty optional reference.
 			 */
 			static Hashmap<std::string, Conversions::Rotation::Unit>::optional_ref TryGuessUnit(const std::string& _symbol) {
-				return s_Lookup.Get(_symbol);
+				return Find<Rotation>(_symbol);
 			}
 			
 			/**
@@ -302,7 +541,7 @@ namespace LouiEriksson::Maths {
 			 *
 			 * @return The converted value.
 			 */
-			[[nodiscard]] static conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
+			[[nodiscard]] static constexpr conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
 				return _val * (s_Conversion[_from] / s_Conversion[_to]);
 			}
 
@@ -315,9 +554,18 @@ namespace LouiEriksson::Maths {
 			 * @return A reference to the symbol associated with the Unit value.
 			 */
 			static const std::string& Symbol(const Unit& _unit) { return s_Symbol[_unit]; }
+			
+			/**
+			 * @brief Get every symbol recognised by TryGuessUnit, paired with the Unit it maps to.
+			 *
+			 * @return A vector of symbol-Unit pairs.
+			 */
+			static std::vector<Hashmap<std::string, Unit>::KeyValuePair> Aliases() { return s_Lookup.GetAll(); }
 		
 		private:
 			
+			friend Conversions;
+			
 			inline static const Hashmap<std::string, Unit> s_Lookup {
 				{ "grad",     Gradian },
 				{ "gradians", Gradian },
@@ -344,12 +592,12 @@ namespace LouiEriksson::Maths {
 			};
 			
 			/** @brief Conversions between common rotational distance units and degrees. */
-			inline static const Hashmap<Unit, conversion_scalar_t> s_Conversion {
+			inline static constexpr auto s_Conversion = MakeUnitTable<Unit, conversion_scalar_t>({
 				{ Gradian,  0.9     },
 	            { Degree,   1.0     },
 	            { Radian,  57.29578 },
 	            { Turn,   360.0     },
-			};
+			});
 		};
 		
 		/**
@@ -370,6 +618,9 @@ namespace LouiEriksson::Maths {
 				Day,
 			};
 			
+			/** @brief The number of units of time. */
+			static constexpr size_t s_Count = Day + 1U;
+			
 			/**
 			 * @brief Tries to guess the Unit based on the provided symbol.
 			 *
@@ -377,7 +628,7 @@ namespace LouiEriksson::Maths {
 			 * @return An optional reference to the Unit enum value if a match is found, otherwise an empty optional reference.
 			 */
 			static Hashmap<std::string, Conversions::Time::Unit>::optional_ref TryGuessUnit(const std::string& _symbol) {
-				return s_Lookup.Get(_symbol);
+				return Find<Time>(_symbol);
 			}
 			
 			/**
@@ -389,7 +640,7 @@ namespace LouiEriksson::Maths {
 			 *
 			 * @return The converted value.
 			 */
-			[[nodiscard]] static conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
+			[[nodiscard]] static constexpr conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
 				return _val * (s_Conversion[_from] / s_Conversion[_to]);
 			}
 
@@ -403,8 +654,17 @@ namespace LouiEriksson::Maths {
 			 */
 			static const std::string& Symbol(const Unit& _unit) { return s_Symbol[_unit]; }
 			
+			/**
+			 * @brief Get every symbol recognised by TryGuessUnit, paired with the Unit it maps to.
+			 *
+			 * @return A vector of symbol-Unit pairs.
+			 */
+			static std::vector<Hashmap<std::string, Unit>::KeyValuePair> Aliases() { return s_Lookup.GetAll(); }
+		
 		private:
 			
+			friend Conversions;
+			
 			inline static const Hashmap<std::string, Unit> s_Lookup {
 			    { "nanosecond",   Nanosecond  },
 	            { "nanoseconds",  Nanosecond  },
@@ -443,7 +703,7 @@ namespace LouiEriksson::Maths {
 			};
 			
 			/** @brief Conversions between common time units and seconds. */
-			inline static const Hashmap<Unit, conversion_scalar_t> s_Conversion {
+			inline static constexpr auto s_Conversion = MakeUnitTable<Unit, conversion_scalar_t>({
 	            { Nanosecond,      0.000000001 },
 				{ Microsecond,     0.000001    },
 	            { Millisecond,     0.001       },
@@ -451,7 +711,7 @@ namespace LouiEriksson::Maths {
 				{ Minute,         60.0         },
 				{ Hour,         3600.0         },
 				{ Day,         86400.0         },
-			};
+			});
 		};
 		
 		/**
@@ -468,6 +728,9 @@ namespace LouiEriksson::Maths {
 				Kelvin,
 			};
 			
+			/** @brief The number of units of temperature. */
+			static constexpr size_t s_Count = Kelvin + 1U;
+			
 			static constexpr conversion_scalar_t s_PlanckTemperature = 14200000000000000000000000000000000.0;
 			static constexpr conversion_scalar_t s_AbsoluteZero      =                                   0.0;
 			
@@ -478,7 +741,7 @@ namespace LouiEriksson::Maths {
 			 * @return An optional reference to the Unit enum value if a match is found, otherwise an empty optional reference.
 			 */
 			static Hashmap<std::string, Conversions::Temperature::Unit>::optional_ref TryGuessUnit(const std::string& _symbol) {
-				return s_Lookup.Get(_symbol);
+				return Find<Temperature>(_symbol);
 			}
 			
 			/**
@@ -490,13 +753,13 @@ namespace LouiEriksson::Maths {
 			 *
 			 * @return The converted value.
 			 */
-			[[nodiscard]] static conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
+			[[nodiscard]] static constexpr conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
 		
 				conversion_scalar_t result{};
 				
 				// Convert to Kelvin:
 				switch (_from) {
-					case Celsius:    { result =  _val - 272.15;        break; }
+					case Celsius:    { result =  _val + 273.15;        break; }
 					case Fahrenheit: { result = (_val + 459.67) / 1.8; break; }
 					case Kelvin:     { result = _val;                  break; }
 					default: {
@@ -510,8 +773,15 @@ namespace LouiEriksson::Maths {
 				
 				// Convert Kelvin to target:
 				switch (_to) {
-					case Celsius:    { result += 273.15;                 break; }
-					case Fahrenheit: { result = (result * 1.8) - 459.67; break; }
+					case Celsius:    { result -= 273.15;                 break; }
+					case Fahrenheit: {
+						
+						result *= 1.8;
+						Round(result);
+						
+						result -= 459.67;
+						break;
+					}
 					case Kelvin:     {                                   break; }
 					default: {
 						throw std::runtime_error("Not implemented!");
@@ -532,6 +802,13 @@ namespace LouiEriksson::Maths {
 			 */
 			static const std::string& Symbol(const Unit& _unit) { return s_Symbol[_unit]; }
 			
+			/**
+			 * @brief Get every symbol recognised by TryGuessUnit, paired with the Unit it maps to.
+			 *
+			 * @return A vector of symbol-Unit pairs.
+			 */
+			static std::vector<Hashmap<std::string, Unit>::KeyValuePair> Aliases() { return s_Lookup.GetAll(); }
+			
 			static conversion_scalar_t ClampTemperature(const conversion_scalar_t& _val, Unit& _unit) {
 				
 				return Convert(
@@ -546,6 +823,8 @@ namespace LouiEriksson::Maths {
 			
 		private:
 			
+			friend Conversions;
+			
 			inline static const Hashmap<std::string, Unit> s_Lookup {
 	            { "celsius",     Celsius    },
 	            { "c",           Celsius    },
@@ -604,6 +883,9 @@ namespace LouiEriksson::Maths {
 				TonneSquareInch_Long,
 			};
 			
+			/** @brief The number of units of pressure. */
+			static constexpr size_t s_Count = TonneSquareInch_Long + 1U;
+			
 			/**
 			 * @brief Tries to guess the Unit based on the provided symbol.
 			 *
@@ -611,7 +893,7 @@ namespace LouiEriksson::Maths {
 			 * @return An optional reference to the Unit enum value if a match is found, otherwise an empty optional reference.
 			 */
 			static Hashmap<std::string, Conversions::Pressure::Unit>::optional_ref TryGuessUnit(const std::string& _symbol) {
-				return s_Lookup.Get(_symbol);
+				return Find<Pressure>(_symbol);
 			}
 			
 			/**
@@ -623,7 +905,7 @@ namespace LouiEriksson::Maths {
 			 *
 			 * @return The converted value.
 			 */
-			[[nodiscard]] static conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
+			[[nodiscard]] static constexpr conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
 				return _val * (s_Conversion[_from] / s_Conversion[_to]);
 			}
 
@@ -637,8 +919,17 @@ namespace LouiEriksson::Maths {
 			 */
 			static const std::string& Symbol(const Unit& _unit) { return s_Symbol[_unit]; }
 			
+			/**
+			 * @brief Get every symbol recognised by TryGuessUnit, paired with the Unit it maps to.
+			 *
+			 * @return A vector of symbol-Unit pairs.
+			 */
+			static std::vector<Hashmap<std::string, Unit>::KeyValuePair> Aliases() { return s_Lookup.GetAll(); }
+		
 		private:
 			
+			friend Conversions;
+			
 			inline static const Hashmap<std::string, Unit> s_Lookup {
 				{ "dyn/cm²",      DyneSquareCentimetre          },
 				{ "dyn/cm^2",     DyneSquareCentimetre          },
@@ -731,7 +1022,7 @@ namespace LouiEriksson::Maths {
 			 * @brief Conversions between common pressure units and atmospheres.
 			 * @see SensorsONE, 2019. atm – Standard Atmosphere Pressure Unit [online]. Sensorsone.com. Available from: https://www.sensorsone.com/atm-standard-atmosphere-pressure-unit/ [Accessed 12 Mar 2024].
 			 */
-			inline static const Hashmap<Unit, conversion_scalar_t> s_Conversion {
+			inline static constexpr auto s_Conversion = MakeUnitTable<Unit, conversion_scalar_t>({
 				{ DyneSquareCentimetre,       0.000000987 },
 				{ MilliTorr,                  0.000001316 },
 				{ Pascal,                     0.000009869 },
@@ -757,7 +1048,7 @@ namespace LouiEriksson::Maths {
 				{ Megapascal,                 9.869232667 },
 				{ TonneSquareInch_Short,    136.092009086 },
 				{ TonneSquareInch_Long,     152.422992094 },
-			};
+			});
 			
 		};
 		
@@ -783,6 +1074,9 @@ namespace LouiEriksson::Maths {
 				Gigaton,
 			};
 			
+			/** @brief The number of units of mass. */
+			static constexpr size_t s_Count = Gigaton + 1U;
+			
 			/**
 			 * @brief Tries to guess the Unit based on the provided symbol.
 			 *
@@ -790,7 +1084,7 @@ namespace LouiEriksson::Maths {
 			 * @return An optional reference to the Unit enum value if a match is found, otherwise an empty optional reference.
 			 */
 			static Hashmap<std::string, Conversions::Mass::Unit>::optional_ref TryGuessUnit(const std::string& _symbol) {
-				return s_Lookup.Get(_symbol);
+				return Find<Mass>(_symbol);
 			}
 			
 			/**
@@ -802,7 +1096,7 @@ namespace LouiEriksson::Maths {
 			 *
 			 * @return The converted value.
 			 */
-			[[nodiscard]] static conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
+			[[nodiscard]] static constexpr conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
 				return _val * (s_Conversion[_from] / s_Conversion[_to]);
 			}
 
@@ -816,8 +1110,17 @@ namespace LouiEriksson::Maths {
 			 */
 			static const std::string& Symbol(const Unit& _unit) { return s_Symbol[_unit]; }
 			
+			/**
+			 * @brief Get every symbol recognised by TryGuessUnit, paired with the Unit it maps to.
+			 *
+			 * @return A vector of symbol-Unit pairs.
+			 */
+			static std::vector<Hashmap<std::string, Unit>::KeyValuePair> Aliases() { return s_Lookup.GetAll(); }
+		
 		private:
 			
+			friend Conversions;
+			
 			inline static const Hashmap<std::string, Unit> s_Lookup {
 					{ "nanogram",     Nanogram  },
 					{ "nanogramme",   Nanogram  },
@@ -885,7 +1188,7 @@ namespace LouiEriksson::Maths {
 			};
 			
 			/** @brief Conversions between common mass units and kilograms. */
-			inline static const Hashmap<Unit, conversion_scalar_t> s_Conversion {
+			inline static constexpr auto s_Conversion = MakeUnitTable<Unit, conversion_scalar_t>({
 					{ Nanogram,              0.000000000001 },
 					{ Microgram,             0.000000001    },
 					{ Milligram,             0.000001       },
@@ -897,7 +1200,7 @@ namespace LouiEriksson::Maths {
 					{ Kiloton,         1000000.0            },
 					{ Megaton,      1000000000.0            },
 					{ Gigaton,   1000000000000.0            },
-			};
+			});
 			
 		};
 		
@@ -920,6 +1223,9 @@ namespace LouiEriksson::Maths {
 				SquareYard,
 			};
 			
+			/** @brief The number of units of area. */
+			static constexpr size_t s_Count = SquareYard + 1U;
+			
 			/**
 			 * @brief Tries to guess the Unit based on the provided symbol.
 			 *
@@ -927,7 +1233,7 @@ namespace LouiEriksson::Maths {
 			 * @return An optional reference to the Unit enum value if a match is found, otherwise an empty optional reference.
 			 */
 			static Hashmap<std::string, Conversions::Area::Unit>::optional_ref TryGuessUnit(const std::string& _symbol) {
-				return s_Lookup.Get(_symbol);
+				return Find<Area>(_symbol);
 			}
 			
 			/**
@@ -939,7 +1245,7 @@ namespace LouiEriksson::Maths {
 			 *
 			 * @return The converted value.
 			 */
-			[[nodiscard]] static conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
+			[[nodiscard]] static constexpr conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
 				return _val * (s_Conversion[_from] / s_Conversion[_to]);
 			}
 
@@ -953,8 +1259,17 @@ namespace LouiEriksson::Maths {
 			 */
 			static const std::string& Symbol(const Unit& _unit) { return s_Symbol[_unit]; }
 			
+			/**
+			 * @brief Get every symbol recognised by TryGuessUnit, paired with the Unit it maps to.
+			 *
+			 * @return A vector of symbol-Unit pairs.
+			 */
+			static std::vector<Hashmap<std::string, Unit>::KeyValuePair> Aliases() { return s_Lookup.GetAll(); }
+		
 		private:
 			
+			friend Conversions;
+			
 			inline static const Hashmap<std::string, Unit> s_Lookup {
 				{ "mm2",     SquareMillimetre },
 				{ "mm^2",    SquareMillimetre },
@@ -994,7 +1309,7 @@ namespace LouiEriksson::Maths {
 			};
 			
 			/** @brief Conversions between area units and square metres. */
-			inline static const Hashmap<Unit, conversion_scalar_t> s_Conversion {
+			inline static constexpr auto s_Conversion = MakeUnitTable<Unit, conversion_scalar_t>({
 				{ SquareMillimetre,    0.000001     },
 				{ SquareCentimetre,    0.0001       },
 				{ SquareInch,          0.00064516   },
@@ -1003,7 +1318,7 @@ namespace LouiEriksson::Maths {
 				{ SquareMetre,         1.0          },
 				{ Acre,             4046.8564224    },
 				{ Hectare,         10000.0          },
-			};
+			});
 		
 		};
 		
@@ -1031,6 +1346,9 @@ namespace LouiEriksson::Maths {
 				CubicMetre,
 			};
 			
+			/** @brief The number of units of volume. */
+			static constexpr size_t s_Count = CubicMetre + 1U;
+			
 			/**
 			 * @brief Tries to guess the Unit based on the provided symbol.
 			 *
@@ -1038,7 +1356,7 @@ namespace LouiEriksson::Maths {
 			 * @return An optional reference to the Unit enum value if a match is found, otherwise an empty optional reference.
 			 */
 			static Hashmap<std::string, Conversions::Volume::Unit>::optional_ref TryGuessUnit(const std::string& _symbol) {
-				return s_Lookup.Get(_symbol);
+				return Find<Volume>(_symbol);
 			}
 			
 			/**
@@ -1050,7 +1368,7 @@ namespace LouiEriksson::Maths {
 			 *
 			 * @return The converted value.
 			 */
-			[[nodiscard]] static conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
+			[[nodiscard]] static constexpr conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) {
 				return _val * (s_Conversion[_from] / s_Conversion[_to]);
 			}
 			
@@ -1064,8 +1382,17 @@ namespace LouiEriksson::Maths {
 			 */
 			static const std::string& Symbol(const Unit& _unit) { return s_Symbol[_unit]; }
 			
+			/**
+			 * @brief Get every symbol recognised by TryGuessUnit, paired with the Unit it maps to.
+			 *
+			 * @return A vector of symbol-Unit pairs.
+			 */
+			static std::vector<Hashmap<std::string, Unit>::KeyValuePair> Aliases() { return s_Lookup.GetAll(); }
+		
 		private:
 			
+			friend Conversions;
+			
 			inline static const Hashmap<std::string, Unit> s_Lookup {
 				{ "milliliter", Millilitre },
 				{ "millilitre", Millilitre },
@@ -1153,7 +1480,7 @@ namespace LouiEriksson::Maths {
 			};
 			
 			/** @brief Conversions between common mass units and cubic metres. */
-			inline static const Hashmap<Unit, conversion_scalar_t> s_Conversion {
+			inline static constexpr auto s_Conversion = MakeUnitTable<Unit, conversion_scalar_t>({
 				{ Millilitre, 0.000001       },
 				{ Centilitre, 0.00001        },
 				{ CubicInch,  0.000016387064 },
@@ -1167,8 +1494,72 @@ namespace LouiEriksson::Maths {
 				{ Barrel,     0.158987294928 },
 				{ CubicYard,  0.764554858    },
 				{ CubicMetre, 1.0            },
-			};
+			});
 		};
+	
+	private:
+		
+		friend Prefixes;
+		
+		/**
+		 * @brief Looks a symbol up in the table of a dimension, timing and counting the lookup if instrumented, and
+		 * logging it if it misses and misses are logged.
+		 */
+		template<typename TDimension>
+		static typename Hashmap<std::string, typename TDimension::Unit>::optional_ref Find(const std::string& _symbol) {
+
+#if defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+			const Instrumentation::Scope scope(Instrumentation::Lookup);
+#endif
+			
+			auto result = Probe<TDimension>(_symbol);
+			
+			Record<TDimension>(_symbol, result.has_value());
+			
+			return result;
+		}
+		
+		/** @brief Looks a symbol up in the table of a dimension, without recording the lookup. */
+		template<typename TDimension>
+		static typename Hashmap<std::string, typename TDimension::Unit>::optional_ref Probe(const std::string& _symbol) {
+			return TDimension::s_Lookup.Get(_symbol);
+		}
+		
+		/**
+		 * @brief Counts a lookup of a dimension if instrumented, and logs it if it missed and misses are logged.
+		 *
+		 * @details Called once for each lookup, by Find or by a lookup which falls back from Probe to other rules
+		 * (such as Prefixes), so that a symbol is only a miss if every rule fails.
+		 */
+		template<typename TDimension>
+		static void Record([[maybe_unused]] const std::string& _symbol, [[maybe_unused]] const bool& _hit) noexcept {
+
+#if defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+			Instrumentation::Counters<TDimension>::CountLookup(_hit);
+#endif
+
+#if defined(LOUIERIKSSON_MATHS_MISS_LOG)
+			if (!_hit) {
+				MissLog::Record(Name<TDimension>(), _symbol);
+			}
+#endif
+		}
+
+#if defined(LOUIERIKSSON_MATHS_REPRODUCIBLE) && defined(__GNUC__) && (defined(__SSE2__) || defined(__aarch64__))
+		
+		/**
+		 * @brief Hides a value from the optimiser, which must then assume that it was modified in a register, and so
+		 * cannot fuse the operations on either side.
+		 */
+		template<typename T>
+		static void Barrier(T& _val) noexcept {
+	#if defined(__aarch64__)
+			__asm__("" : "+w"(_val));
+	#else
+			__asm__("" : "+x"(_val));
+	#endif
+		}
+#endif
 	};
 	
 } // LouiEriksson::Maths
@@ -0,0 +1,550 @@
+#ifndef LOUIERIKSSON_DMS_HPP
+#define LOUIERIKSSON_DMS_HPP
+
+#include "Conversions.hpp"
+#include "Parsing.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <system_error>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#endif
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @struct DMS
+	 * @brief Parsing, formatting and batch conversion of angles written in degrees, minutes and seconds.
+	 *
+	 * @details Angles are parsed and formatted without allocating, and without regular expressions or locales. The
+	 * parser accepts the forms found in maritime and aviation feeds:
+	 *
+	 * @code
+	 * 48°51'29.6"N     48° 51′ 29.6″ N     N 48 51 29.6     -48:51:29.6     48°51.493'N     48.858222°
+	 * @endcode
+	 *
+	 * Batch conversions operate on separate arrays of degrees, minutes and seconds, and convert to or from any
+	 * Rotation::Unit through the factors of Conversions::Rotation, with AVX2 where available.
+	 */
+	struct DMS final {
+		
+		/**
+		 * @enum Axis
+		 * @brief The hemisphere letters used to write the sign of an angle.
+		 */
+		enum Axis : unsigned char {
+			None,      /**< @brief Negative angles are written with a leading '-'. */
+			Latitude,  /**< @brief Angles are suffixed with 'N', or 'S' if negative. */
+			Longitude, /**< @brief Angles are suffixed with 'E', or 'W' if negative. */
+		};
+		
+		/**
+		 * @brief Parses an angle written in degrees, minutes and seconds.
+		 *
+		 * @details Minutes and seconds are optional, and may be fractional only if no smaller component follows. Each
+		 * component may be followed by its mark (`°`, `º` or `d`; `'` or `′`; `"`, `″` or `''`), a ':', or whitespace.
+		 * The sign is given either by a leading '-' or by a hemisphere letter (N, S, E or W) before or after the angle,
+		 * but not both.
+		 *
+		 * @param[in] _text The text to parse.
+		 * @param[out] _degrees The angle in decimal degrees. Unmodified if parsing fails.
+		 * @return True if the whole of the text was parsed.
+		 */
+		[[nodiscard]] static bool TryParse(const std::string_view& _text, double& _degrees) noexcept {
+			
+			const auto* p   = _text.data();
+			const auto* end = _text.data() + _text.size();
+			
+			SkipSpace(p, end);
+			
+			int hemisphere = Hemisphere(p, end);
+			
+			if (hemisphere != 0) {
+				++p;
+				SkipSpace(p, end);
+			}
+			
+			bool negative = false;
+			
+			if (p != end && (*p == '-' || *p == '+')) {
+				negative = *p == '-';
+				++p;
+			}
+			
+			std::array<double, 3U> parts { 0.0, 0.0, 0.0 };
+			size_t count = 0U;
+			
+			bool fractional = false;
+			
+			while (count < parts.size() && p != end && IsDigit(*p)) {
+				
+				// A fractional component must be the last.
+				if (fractional) {
+					return false;
+				}
+				
+				if (!TryParseComponent(p, end, parts[count], fractional)) {
+					return false;
+				}
+				
+				const auto mark = Mark(p, end);
+				
+				if (mark != 0 && mark != static_cast<int>(count) + 1 && mark != s_Separator) {
+					return false;
+				}
+				
+				SkipSpace(p, end);
+				
+				++count;
+			}
+			
+			if (count == 0U || parts[1U] >= 60.0 || parts[2U] >= 60.0) {
+				return false;
+			}
+			
+			if (hemisphere == 0) {
+				
+				hemisphere = Hemisphere(p, end);
+				
+				if (hemisphere != 0) {
+					++p;
+					SkipSpace(p, end);
+				}
+			}
+			else if (Hemisphere(p, end) != 0) {
+				return false;
+			}
+			
+			if (p != end || (negative && hemisphere != 0)) {
+				return false;
+			}
+			
+			const auto magnitude = parts[0U] + (parts[1U] / 60.0) + (parts[2U] / 3600.0);
+			
+			_degrees = (negative || hemisphere < 0) ? -magnitude : magnitude;
+			
+			return true;
+		}
+		
+		/**
+		 * @brief Parses many angles written in degrees, minutes and seconds, converting each to a unit of rotation.
+		 *
+		 * @param[in] _texts The texts to parse.
+		 * @param[in] _size The number of texts.
+		 * @param[in] _to The unit to convert to.
+		 * @param[out] _out Destination for the converted values. Must hold _size values. Texts which cannot be
+		 * parsed produce NaN.
+		 * @return The number of texts which were parsed.
+		 */
+		static size_t Parse(const std::string_view* _texts, const size_t& _size, const Conversions::Rotation::Unit& _to, double* _out) noexcept {
+			
+			const auto scale = static_cast<double>(Conversions::Plan::Make<Conversions::Rotation>(Conversions::Rotation::Degree, _to).m_Scale);
+			
+			size_t result = 0U;
+			
+			for (size_t i = 0U; i < _size; ++i) {
+				
+				double degrees;
+				
+				if (TryParse(_texts[i], degrees)) {
+					_out[i] = degrees * scale;
+					++result;
+				}
+				else {
+					_out[i] = std::numeric_limits<double>::quiet_NaN();
+				}
+			}
+			
+			return result;
+		}
+		
+		/**
+		 * @brief Formats an angle as degrees, minutes and seconds, such as `48°51'29.6"N`.
+		 *
+		 * @details The angle is rounded to the requested number of decimal places of a second before it is split, so
+		 * carries propagate (59.96" rounds to the next minute rather than to 60.0").
+		 *
+		 * @param[in] _degrees The angle in decimal degrees.
+		 * @param[in] _axis How the sign of the angle is written.
+		 * @param[in] _precision The number of decimal places of the seconds, at most 9.
+		 * @param[out] _buffer Destination for the text, which is not null-terminated.
+		 * @param[in] _capacity The size of the buffer.
+		 * @return The number of characters written, or zero if the angle is not finite, is too large to be represented
+		 * at the requested precision, or does not fit in the buffer.
+		 */
+		static size_t Format(const double& _degrees, const Axis& _axis, const unsigned& _precision, char* _buffer, const size_t& _capacity) noexcept {
+			
+			static constexpr std::array<uint64_t, 10U> s_Scales {
+				1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U,
+			};
+			
+			if (_precision >= s_Scales.size() || !std::isfinite(_degrees)) {
+				return 0U;
+			}
+			
+			const auto units = std::round(std::fabs(_degrees) * 3600.0 * static_cast<double>(s_Scales[_precision]));
+			
+			if (units >= 9007199254740992.0) {
+				return 0U;
+			}
+			
+			const auto total      = static_cast<uint64_t>(units);
+			const auto per_second = s_Scales[_precision];
+			
+			const auto fraction =  total % per_second;
+			const auto seconds  = (total / per_second) % 60U;
+			const auto minutes  = (total / (per_second * 60U)) % 60U;
+			const auto degrees  =  total / (per_second * 3600U);
+			
+			const bool negative = std::signbit(_degrees) && total != 0U;
+			
+			// Degrees (at most 16 digits given the bound above), the marks, the fraction and a sign or hemisphere.
+			char text[48];
+			char* p = text;
+			
+			if (negative && _axis == None) {
+				*p++ = '-';
+			}
+			
+			p = WriteDigits(p, degrees, 1U);
+			*p++ = '\xC2';
+			*p++ = '\xB0';
+			
+			p = WriteDigits(p, minutes, 2U);
+			*p++ = '\'';
+			
+			p = WriteDigits(p, seconds, 2U);
+			
+			if (_precision != 0U) {
+				*p++ = '.';
+				p = WriteDigits(p, fraction, _precision);
+			}
+			
+			*p++ = '"';
+			
+			if (_axis == Latitude) {
+				*p++ = negative ? 'S' : 'N';
+			}
+			else if (_axis == Longitude) {
+				*p++ = negative ? 'W' : 'E';
+			}
+			
+			const auto length = static_cast<size_t>(p - text);
+			
+			if (length > _capacity) {
+				return 0U;
+			}
+			
+			std::copy(text, p, _buffer);
+			
+			return length;
+		}
+		
+		/**
+		 * @brief Converts angles given as separate degrees, minutes and seconds to a unit of rotation.
+		 *
+		 * @details The sign of each angle is taken from its degrees (including negative zero, for angles of less than a
+		 * degree), and minutes and seconds are treated as magnitudes.
+		 *
+		 * @param[in] _degrees The whole (or fractional) degrees.
+		 * @param[in] _minutes The minutes.
+		 * @param[in] _seconds The seconds.
+		 * @param[in] _size The number of angles.
+		 * @param[in] _to The unit to convert to.
+		 * @param[out] _out Destination for the converted values. Must hold _size values, and may alias any input.
+		 */
+		static void ToUnit(const double* _degrees, const double* _minutes, const double* _seconds, const size_t& _size, const Conversions::Rotation::Unit& _to, double* _out) noexcept {
+			
+			// Summing in seconds keeps whole degrees and minutes exact, so only the seconds and the scale round.
+			const auto scale = static_cast<double>(Conversions::Plan::Make<Conversions::Rotation>(Conversions::Rotation::Degree, _to).m_Scale) / 3600.0;
+			
+			size_t i = 0U;
+
+#if defined(__AVX2__)
+			
+			const auto sign  = _mm256_set1_pd(-0.0);
+			const auto s60   = _mm256_set1_pd(60.0);
+			const auto s3600 = _mm256_set1_pd(3600.0);
+			const auto k     = _mm256_set1_pd(scale);
+			
+			for (; i + 4U <= _size; i += 4U) {
+				
+				const auto d = _mm256_loadu_pd(_degrees + i);
+				
+				auto degrees = _mm256_mul_pd(_mm256_andnot_pd(sign, d), s3600);
+				auto minutes = _mm256_mul_pd(_mm256_andnot_pd(sign, _mm256_loadu_pd(_minutes + i)), s60);
+				Conversions::Round(degrees);
+				Conversions::Round(minutes);
+				
+				auto sum = _mm256_add_pd(degrees, minutes);
+				sum = _mm256_add_pd(sum, _mm256_andnot_pd(sign, _mm256_loadu_pd(_seconds + i)));
+				
+				_mm256_storeu_pd(_out + i, _mm256_or_pd(_mm256_mul_pd(sum, k), _mm256_and_pd(sign, d)));
+			}
+#endif
+			
+			for (; i < _size; ++i) {
+				
+				auto degrees = std::fabs(_degrees[i]) * 3600.0;
+				auto minutes = std::fabs(_minutes[i]) *   60.0;
+				Conversions::Round(degrees);
+				Conversions::Round(minutes);
+				
+				const auto sum = (degrees + minutes) + std::fabs(_seconds[i]);
+				
+				_out[i] = std::copysign(sum * scale, _degrees[i]);
+			}
+		}
+		
+		/**
+		 * @brief Converts angles in a unit of rotation to separate degrees, minutes and seconds.
+		 *
+		 * @details Degrees and minutes are whole numbers, and the sign of each angle is carried by its degrees
+		 * (negative zero for negative angles of less than a degree).
+		 *
+		 * @param[in] _in The angles.
+		 * @param[in] _size The number of angles.
+		 * @param[in] _from The unit of the angles.
+		 * @param[out] _degrees Destination for the degrees. Must hold _size values.
+		 * @param[out] _minutes Destination for the minutes. Must hold _size values.
+		 * @param[out] _seconds Destination for the seconds. Must hold _size values.
+		 */
+		static void FromUnit(const double* _in, const size_t& _size, const Conversions::Rotation::Unit& _from, double* _degrees, double* _minutes, double* _seconds) noexcept {
+			
+			const auto scale = static_cast<double>(Conversions::Plan::Make<Conversions::Rotation>(_from, Conversions::Rotation::Degree).m_Scale) * 3600.0;
+			
+			size_t i = 0U;
+
+#if defined(__AVX2__)
+			
+			const auto sign  = _mm256_set1_pd(-0.0);
+			const auto zero  = _mm256_setzero_pd();
+			const auto s60   = _mm256_set1_pd(60.0);
+			const auto s3600 = _mm256_set1_pd(3600.0);
+			const auto k     = _mm256_set1_pd(scale);
+			
+			for (; i + 4U <= _size; i += 4U) {
+				
+				const auto x = _mm256_loadu_pd(_in + i);
+				
+				const auto total = _mm256_mul_pd(_mm256_andnot_pd(sign, x), k);
+				
+				auto d   = _mm256_floor_pd(_mm256_div_pd(total, s3600));
+				auto rem = _mm256_sub_pd(total, _mm256_mul_pd(d, s3600));
+				
+				// The quotient may round up to the next whole degree, leaving a small negative remainder.
+				const auto under = _mm256_cmp_pd(rem, zero, _CMP_LT_OQ);
+				d   = _mm256_sub_pd(d,   _mm256_and_pd(under, _mm256_set1_pd(1.0)));
+				rem = _mm256_add_pd(rem, _mm256_and_pd(under, s3600));
+				
+				const auto m = _mm256_floor_pd(_mm256_div_pd(rem, s60));
+				
+				_mm256_storeu_pd(_degrees + i, _mm256_or_pd(d, _mm256_and_pd(sign, x)));
+				_mm256_storeu_pd(_minutes + i, m);
+				_mm256_storeu_pd(_seconds + i, _mm256_max_pd(_mm256_sub_pd(rem, _mm256_mul_pd(m, s60)), zero));
+			}
+#endif
+			
+			for (; i < _size; ++i) {
+				
+				const auto total = std::fabs(_in[i]) * scale;
+				
+				auto d   = std::floor(total / 3600.0);
+				auto rem = total - (d * 3600.0);
+				
+				// The quotient may round up to the next whole degree, leaving a small negative remainder.
+				if (rem < 0.0) {
+					d   -= 1.0;
+					rem += 3600.0;
+				}
+				
+				const auto m = std::floor(rem / 60.0);
+				
+				_degrees[i] = std::copysign(d, _in[i]);
+				_minutes[i] = m;
+				_seconds[i] = std::fmax(rem - (m * 60.0), 0.0);
+			}
+		}
+	
+	private:
+		
+		/** @brief Returned by Mark for a ':' or whitespace, which may separate any components. */
+		static constexpr int s_Separator = -1;
+		
+		[[nodiscard]] static constexpr bool IsDigit(const char& _c) noexcept { return _c >= '0' && _c <= '9'; }
+		
+		static constexpr void SkipSpace(const char*& _p, const char* _end) noexcept {
+			while (_p != _end && (*_p == ' ' || *_p == '\t')) { ++_p; }
+		}
+		
+		/**
+		 * @brief Identifies a hemisphere letter.
+		 *
+		 * @return 1 for N or E, -1 for S or W, or 0 if there is none.
+		 */
+		[[nodiscard]] static constexpr int Hemisphere(const char* _p, const char* _end) noexcept {
+			
+			if (_p == _end) {
+				return 0;
+			}
+			
+			switch (*_p) {
+				case 'N': case 'n': case 'E': case 'e': { return  1; }
+				case 'S': case 's': case 'W': case 'w': { return -1; }
+				default: { return 0; }
+			}
+		}
+		
+		/**
+		 * @brief Consumes the mark following a component.
+		 *
+		 * @return 1 for a degree mark, 2 for a minute mark, 3 for a second mark, s_Separator for a ':' or whitespace,
+		 * or 0 if there is none.
+		 */
+		[[nodiscard]] static int Mark(const char*& _p, const char* _end) noexcept {
+			
+			const auto remaining = _end - _p;
+			
+			if (remaining == 0) {
+				return 0;
+			}
+			
+			switch (_p[0]) {
+				case 'd': { _p += 1; return 1; }
+				case '"': { _p += 1; return 3; }
+				case ':':
+				case ' ': { _p += 1; return s_Separator; }
+				case '\'': {
+					
+					// Two apostrophes are read as a second mark.
+					if (remaining > 1 && _p[1] == '\'') {
+						_p += 2;
+						return 3;
+					}
+					
+					_p += 1;
+					return 2;
+				}
+				case '\xC2': { // DEGREE SIGN (U+00B0), or MASCULINE ORDINAL INDICATOR (U+00BA) in its place.
+					
+					if (remaining > 1 && (_p[1] == '\xB0' || _p[1] == '\xBA')) {
+						_p += 2;
+						return 1;
+					}
+					
+					return 0;
+				}
+				case '\xE2': { // PRIME (U+2032) or DOUBLE PRIME (U+2033).
+					
+					if (remaining > 2 && _p[1] == '\x80' && (_p[2] == '\xB2' || _p[2] == '\xB3')) {
+						
+						const auto result = _p[2] == '\xB2' ? 2 : 3;
+						
+						_p += 3;
+						return result;
+					}
+					
+					return 0;
+				}
+				default: {
+					return 0;
+				}
+			}
+		}
+		
+		/**
+		 * @brief Parses an unsigned decimal component, such as "51" or "29.6".
+		 *
+		 * @details Components of up to 15 significant digits are divided exactly by a power of ten, which is
+		 * correctly rounded as both operands are exact. Longer components fall back to Parsing::FromChars.
+		 *
+		 * @param[in,out] _p The first character, advanced past the component.
+		 * @param[in] _end One past the last character.
+		 * @param[out] _value The parsed value.
+		 * @param[in,out] _fractional Set if the component has a fractional part.
+		 * @return True if a component was parsed.
+		 */
+		[[nodiscard]] static bool TryParseComponent(const char*& _p, const char* _end, double& _value, bool& _fractional) noexcept {
+			
+			static constexpr std::array<double, 16U> s_Powers {
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+			};
+			
+			const auto* p = _p;
+			
+			uint64_t mantissa = 0U;
+			size_t   digits   = 0U;
+			size_t   decimals = 0U;
+			
+			for (; p != _end && IsDigit(*p); ++p, ++digits) {
+				mantissa = (mantissa * 10U) + static_cast<uint64_t>(*p - '0');
+			}
+			
+			if (p != _end && *p == '.') {
+				
+				_fractional = true;
+				
+				for (++p; p != _end && IsDigit(*p); ++p, ++decimals) {
+					mantissa = (mantissa * 10U) + static_cast<uint64_t>(*p - '0');
+				}
+				
+				if (decimals == 0U) {
+					return false;
+				}
+			}
+			
+			if (digits + decimals < s_Powers.size()) {
+				_value = static_cast<double>(mantissa) / s_Powers[decimals];
+			}
+			else {
+				
+				const auto result = Parsing::FromChars(_p, p, _value);
+				
+				if (result.ec != std::errc() || result.ptr != p) {
+					return false;
+				}
+			}
+			
+			_p = p;
+			
+			return true;
+		}
+		
+		/**
+		 * @brief Writes an unsigned integer in decimal, padded with leading zeros.
+		 *
+		 * @return One past the last character written.
+		 */
+		static char* WriteDigits(char* _p, uint64_t _value, const size_t& _width) noexcept {
+			
+			char digits[20];
+			size_t count = 0U;
+			
+			do {
+				digits[count++] = static_cast<char>('0' + (_value % 10U));
+				_value /= 10U;
+			}
+			while (_value != 0U);
+			
+			for (auto i = count; i < _width; ++i) {
+				*_p++ = '0';
+			}
+			
+			while (count != 0U) {
+				*_p++ = digits[--count];
+			}
+			
+			return _p;
+		}
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_DMS_HPP
@@ -0,0 +1,228 @@
+#ifndef LOUIERIKSSON_EXPRESSIONS_HPP
+#define LOUIERIKSSON_EXPRESSIONS_HPP
+
+#include "Conversions.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace LouiEriksson::Maths::Expressions {
+	
+	/**
+	 * @brief Base of all expressions over unit-tagged arrays.
+	 *
+	 * @details Expressions are built with the arithmetic operators and evaluated into a target unit in a single
+	 * loop. Binding an expression to a target unit folds the conversion factor (and any scalar coefficients) of
+	 * every operand into that operand, so evaluation is a fused multiply-add over the source arrays with no
+	 * temporaries.
+	 */
+	template<typename TDerived>
+	struct Expression {
+		
+		[[nodiscard]] constexpr const TDerived& Derived() const noexcept { return static_cast<const TDerived&>(*this); }
+	};
+	
+	/**
+	 * @class Array
+	 * @brief A non-owning view of a contiguous array of values stored in a unit of TDimension.
+	 */
+	template<typename TDimension, typename T = double>
+	class Array final : public Expression<Array<TDimension, T>> {
+		
+		static_assert(std::is_floating_point_v<T>, "Array values must be of a floating-point type.");
+		static_assert(!std::is_same_v<TDimension, Conversions::Temperature>, "Temperature is affine and cannot be combined arithmetically.");
+	
+	public:
+		
+		using dimension_t = TDimension;
+		using value_t     = T;
+		using unit_t      = typename TDimension::Unit;
+		
+		/**
+		 * @brief Creates a view of an array of values.
+		 *
+		 * @param[in] _data Pointer to the first value.
+		 * @param[in] _size The number of values.
+		 * @param[in] _unit The unit the values are stored in.
+		 */
+		constexpr Array(const T* _data, const size_t& _size, const unit_t& _unit) noexcept :
+			m_Data(_data),
+			m_Size(_size),
+			m_Unit(_unit),
+			m_Factor(1.0) {}
+		
+		[[nodiscard]] constexpr size_t size() const noexcept { return m_Size; }
+		
+		[[nodiscard]] constexpr const unit_t& Unit() const noexcept { return m_Unit; }
+		
+		/**
+		 * @brief Folds the conversion into _to, multiplied by _scale, into this operand.
+		 *
+		 * @param[in] _to The unit the expression is evaluated in.
+		 * @param[in] _scale The product of the scalar coefficients applied to this operand.
+		 */
+		void Bind(const unit_t& _to, const Conversions::conversion_scalar_t& _scale) {
+			m_Factor = static_cast<T>(Conversions::Plan::Make<TDimension>(m_Unit, _to).m_Scale * _scale);
+		}
+		
+		[[nodiscard]] constexpr T operator[](const size_t& _i) const noexcept {
+			
+			// Rounded before it is summed with other operands, so the sum cannot be contracted.
+			auto result = m_Data[_i] * m_Factor;
+			Conversions::Round(result);
+			
+			return result;
+		}
+	
+	private:
+		
+		const T* m_Data;
+		size_t   m_Size;
+		unit_t   m_Unit;
+		T        m_Factor;
+	};
+	
+	/**
+	 * @class Sum
+	 * @brief The sum (or difference) of two expressions of the same dimension.
+	 */
+	template<typename TLeft, typename TRight, bool Subtract>
+	class Sum final : public Expression<Sum<TLeft, TRight, Subtract>> {
+		
+		static_assert(std::is_same_v<typename TLeft::dimension_t, typename TRight::dimension_t>, "Operands must share a dimension.");
+		static_assert(std::is_same_v<typename TLeft::value_t,     typename TRight::value_t    >, "Operands must share a value type.");
+	
+	public:
+		
+		using dimension_t = typename TLeft::dimension_t;
+		using value_t     = typename TLeft::value_t;
+		using unit_t      = typename TLeft::unit_t;
+		
+		Sum(const TLeft& _lhs, const TRight& _rhs) :
+			m_Lhs(_lhs),
+			m_Rhs(_rhs)
+		{
+			if (m_Lhs.size() != m_Rhs.size()) {
+				throw std::length_error("Operands must be of equal size.");
+			}
+		}
+		
+		[[nodiscard]] constexpr size_t size() const noexcept { return m_Lhs.size(); }
+		
+		void Bind(const unit_t& _to, const Conversions::conversion_scalar_t& _scale) {
+			m_Lhs.Bind(_to, _scale);
+			m_Rhs.Bind(_to, Subtract ? -_scale : _scale);
+		}
+		
+		/* Subtraction is folded into the sign of the right operand's factor when bound. */
+		[[nodiscard]] constexpr value_t operator[](const size_t& _i) const noexcept { return m_Lhs[_i] + m_Rhs[_i]; }
+	
+	private:
+		
+		TLeft  m_Lhs;
+		TRight m_Rhs;
+	};
+	
+	/**
+	 * @class Scaled
+	 * @brief An expression multiplied by a dimensionless scalar.
+	 *
+	 * @note The scalar is folded into the factors of the operands when bound, so it costs nothing per element.
+	 */
+	template<typename TExpr>
+	class Scaled final : public Expression<Scaled<TExpr>> {
+	
+	public:
+		
+		using dimension_t = typename TExpr::dimension_t;
+		using value_t     = typename TExpr::value_t;
+		using unit_t      = typename TExpr::unit_t;
+		
+		constexpr Scaled(const TExpr& _expr, const Conversions::conversion_scalar_t& _scalar) noexcept :
+			m_Expr(_expr),
+			m_Scalar(_scalar) {}
+		
+		[[nodiscard]] constexpr size_t size() const noexcept { return m_Expr.size(); }
+		
+		void Bind(const unit_t& _to, const Conversions::conversion_scalar_t& _scale) {
+			m_Expr.Bind(_to, _scale * m_Scalar);
+		}
+		
+		[[nodiscard]] constexpr value_t operator[](const size_t& _i) const noexcept { return m_Expr[_i]; }
+	
+	private:
+		
+		TExpr m_Expr;
+		Conversions::conversion_scalar_t m_Scalar;
+	};
+	
+	template<typename TLeft, typename TRight>
+	[[nodiscard]] Sum<TLeft, TRight, false> operator+(const Expression<TLeft>& _lhs, const Expression<TRight>& _rhs) {
+		return { _lhs.Derived(), _rhs.Derived() };
+	}
+	
+	template<typename TLeft, typename TRight>
+	[[nodiscard]] Sum<TLeft, TRight, true> operator-(const Expression<TLeft>& _lhs, const Expression<TRight>& _rhs) {
+		return { _lhs.Derived(), _rhs.Derived() };
+	}
+	
+	template<typename TExpr>
+	[[nodiscard]] constexpr Scaled<TExpr> operator-(const Expression<TExpr>& _expr) {
+		return { _expr.Derived(), -1.0 };
+	}
+	
+	template<typename TExpr>
+	[[nodiscard]] constexpr Scaled<TExpr> operator*(const Expression<TExpr>& _expr, const Conversions::conversion_scalar_t& _scalar) {
+		return { _expr.Derived(), _scalar };
+	}
+	
+	template<typename TExpr>
+	[[nodiscard]] constexpr Scaled<TExpr> operator*(const Conversions::conversion_scalar_t& _scalar, const Expression<TExpr>& _expr) {
+		return { _expr.Derived(), _scalar };
+	}
+	
+	template<typename TExpr>
+	[[nodiscard]] constexpr Scaled<TExpr> operator/(const Expression<TExpr>& _expr, const Conversions::conversion_scalar_t& _scalar) {
+		return { _expr.Derived(), 1.0 / _scalar };
+	}
+	
+	/**
+	 * @brief Evaluates an expression into a target unit.
+	 *
+	 * @param[in] _expr The expression to evaluate.
+	 * @param[in] _to The unit to produce the result in.
+	 * @param[out] _out Destination for the result. Must hold _expr.size() values, and may alias any operand.
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * const Expressions::Array<Conversions::Distance> a(a_km.data(), a_km.size(), Conversions::Distance::Kilometre);
+	 * const Expressions::Array<Conversions::Distance> b(b_mi.data(), b_mi.size(), Conversions::Distance::Mile);
+	 * const Expressions::Array<Conversions::Distance> c(c_ft.data(), c_ft.size(), Conversions::Distance::Foot);
+	 *
+	 * Expressions::Evaluate(a + b * 2 - c, Conversions::Distance::Metre, result.data());
+	 * @endcode
+	 */
+	template<typename TExpr>
+	void Evaluate(const Expression<TExpr>& _expr, const typename TExpr::unit_t& _to, typename TExpr::value_t* _out) {
+
+#if defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+		const Instrumentation::Scope scope(Instrumentation::Batch);
+#endif
+		
+		auto bound = _expr.Derived();
+		bound.Bind(_to, 1.0);
+
+#if defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+		Instrumentation::Counters<typename TExpr::dimension_t>::CountBatch(bound.size());
+#endif
+		
+		for (size_t i = 0U; i < bound.size(); ++i) {
+			_out[i] = bound[i];
+		}
+	}
+	
+} // LouiEriksson::Maths::Expressions
+
+#endif //LOUIERIKSSON_EXPRESSIONS_HPP
@@ -0,0 +1,278 @@
+#ifndef LOUIERIKSSON_FUZZY_MATCHER_HPP
+#define LOUIERIKSSON_FUZZY_MATCHER_HPP
+
+#include "Conversions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @class FuzzyMatcher
+	 * @brief Finds the known unit symbols nearest to an unrecognised one, across every dimension.
+	 *
+	 * @details Intended as a fallback for when TryGuessUnit misses, such as for misspellings like "hectopscal" or
+	 * "miliseconds". Every alias of every dimension is packed into a single string pool, ordered by length, so only
+	 * aliases whose length is within the maximum distance of the query are considered. Each is compared with the
+	 * bit-parallel edit distance algorithm of Myers (as formulated by Hyyrö), which processes a whole column of the
+	 * dynamic-programming matrix per character with a handful of word operations, and abandons an alias as soon as
+	 * its distance cannot fall within the maximum.
+	 *
+	 * Distances are Levenshtein distances over bytes, so a multi-byte UTF-8 character which differs counts as
+	 * several edits, and a transposition counts as two.
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * const FuzzyMatcher matcher;
+	 *
+	 * for (const auto& candidate : matcher.Match("hectopscal")) {
+	 *     // candidate.m_Symbol == "hectopascal", candidate.m_Dimension == "Pressure", candidate.m_Distance == 1
+	 * }
+	 *
+	 * const auto unit = matcher.TryGuessUnit<Conversions::Time>("miliseconds"); // Millisecond
+	 * @endcode
+	 */
+	class FuzzyMatcher final {
+	
+	public:
+		
+		/** @brief The longest query which can be matched. Longer queries match nothing. */
+		static constexpr size_t s_MaxQueryLength = 64U;
+		
+		/**
+		 * @struct Candidate
+		 * @brief A known symbol near to the query.
+		 */
+		struct Candidate final {
+			
+			/** @brief The known symbol. */
+			std::string_view m_Symbol;
+			
+			/** @brief The name of the dimension of the unit, as given by Conversions::Name. */
+			std::string_view m_Dimension;
+			
+			/** @brief The value of the Unit enum of the dimension. */
+			unsigned char m_Unit;
+			
+			/** @brief The edit distance between the query and the symbol. */
+			size_t m_Distance;
+		};
+		
+		/** @brief Creates a FuzzyMatcher over the aliases of every built-in dimension. */
+		FuzzyMatcher() {
+			
+			std::vector<Entry> entries;
+			std::string        pool;
+			
+			Gather<Conversions::Speed>(entries, pool);
+			Gather<Conversions::Distance>(entries, pool);
+			Gather<Conversions::Rotation>(entries, pool);
+			Gather<Conversions::Time>(entries, pool);
+			Gather<Conversions::Temperature>(entries, pool);
+			Gather<Conversions::Pressure>(entries, pool);
+			Gather<Conversions::Mass>(entries, pool);
+			Gather<Conversions::Area>(entries, pool);
+			Gather<Conversions::Volume>(entries, pool);
+			
+			std::stable_sort(entries.begin(), entries.end(), [](const Entry& _lhs, const Entry& _rhs) {
+				return _lhs.m_Length < _rhs.m_Length;
+			});
+			
+			m_Pool    = std::move(pool);
+			m_Entries = std::move(entries);
+			
+			// m_ByLength[n] is the index of the first entry of length n or greater.
+			const auto longest = m_Entries.empty() ? 0U : m_Entries.back().m_Length;
+			
+			m_ByLength.resize(longest + 2U);
+			
+			for (size_t length = 0U; length < m_ByLength.size(); ++length) {
+				
+				m_ByLength[length] = static_cast<size_t>(std::lower_bound(m_Entries.begin(), m_Entries.end(), length, [](const Entry& _entry, const size_t& _length) {
+					return _entry.m_Length < _length;
+				}) - m_Entries.begin());
+			}
+		}
+		
+		/**
+		 * @brief Finds the known symbols within an edit distance of a query.
+		 *
+		 * @param[in] _query The unrecognised symbol.
+		 * @param[in] _maxDistance The greatest edit distance to accept.
+		 * @param[in] _maxResults The greatest number of candidates to return.
+		 * @return The candidates, nearest first. Ties are ordered by dimension, then by the order of the aliases in
+		 * their dimension.
+		 */
+		[[nodiscard]] std::vector<Candidate> Match(const std::string_view& _query, const size_t& _maxDistance = 2U, const size_t& _maxResults = 5U) const {
+			
+			std::vector<Candidate> result;
+			
+			if (_query.empty() || _query.size() > s_MaxQueryLength) {
+				return result;
+			}
+			
+			// The positions at which each byte occurs in the query.
+			std::array<uint64_t, 256U> peq{};
+			
+			for (size_t i = 0U; i < _query.size(); ++i) {
+				peq[static_cast<unsigned char>(_query[i])] |= uint64_t(1U) << i;
+			}
+			
+			const auto shortest = _query.size() > _maxDistance ? _query.size() - _maxDistance : 0U;
+			const auto longest  = _query.size() + _maxDistance;
+			
+			const auto first = m_ByLength[std::min(shortest,      m_ByLength.size() - 1U)];
+			const auto last  = m_ByLength[std::min(longest  + 1U, m_ByLength.size() - 1U)];
+			
+			for (size_t i = first; i < last; ++i) {
+				
+				const auto& entry = m_Entries[i];
+				
+				const std::string_view symbol(m_Pool.data() + entry.m_Offset, entry.m_Length);
+				
+				if (const auto distance = Distance(peq, _query.size(), symbol, _maxDistance); distance <= _maxDistance) {
+					result.push_back({ symbol, entry.m_Dimension, entry.m_Unit, distance });
+				}
+			}
+			
+			std::stable_sort(result.begin(), result.end(), [](const Candidate& _lhs, const Candidate& _rhs) {
+				return _lhs.m_Distance < _rhs.m_Distance;
+			});
+			
+			if (result.size() > _maxResults) {
+				result.resize(_maxResults);
+			}
+			
+			return result;
+		}
+		
+		/**
+		 * @brief Tries to guess the Unit of a dimension from a symbol, accepting the nearest known symbol if it is
+		 * unrecognised.
+		 *
+		 * @param[in] _symbol The symbol to try to guess the Unit from.
+		 * @param[in] _maxDistance The greatest edit distance to accept.
+		 * @return The Unit of the exact symbol if it is known, otherwise of the nearest symbol of the dimension
+		 * within _maxDistance, provided that no other unit of the dimension is equally near.
+		 */
+		template<typename TDimension>
+		[[nodiscard]] std::optional<typename TDimension::Unit> TryGuessUnit(const std::string& _symbol, const size_t& _maxDistance = 2U) const {
+			
+			if (const auto exact = TDimension::TryGuessUnit(_symbol)) {
+				return exact.value();
+			}
+			
+			std::optional<typename TDimension::Unit> result;
+			
+			size_t best = _maxDistance + 1U;
+			
+			for (const auto& candidate : Match(_symbol, _maxDistance, m_Entries.size())) {
+				
+				if (candidate.m_Dimension != Conversions::Name<TDimension>()) {
+					continue;
+				}
+				
+				const auto unit = static_cast<typename TDimension::Unit>(candidate.m_Unit);
+				
+				if (candidate.m_Distance < best) {
+					best   = candidate.m_Distance;
+					result = unit;
+				}
+				else if (candidate.m_Distance == best && result != unit) {
+					return std::nullopt; // Ambiguous.
+				}
+			}
+			
+			return result;
+		}
+	
+	private:
+		
+		struct Entry final {
+			
+			uint32_t m_Offset;
+			uint32_t m_Length;
+			
+			std::string_view m_Dimension;
+			
+			unsigned char m_Unit;
+		};
+		
+		std::string m_Pool;
+		
+		std::vector<Entry> m_Entries;
+		
+		std::vector<size_t> m_ByLength;
+		
+		template<typename TDimension>
+		static void Gather(std::vector<Entry>& _entries, std::string& _pool) {
+			
+			for (const auto& alias : TDimension::Aliases()) {
+				
+				_entries.push_back({
+					static_cast<uint32_t>(_pool.size()),
+					static_cast<uint32_t>(alias.first.size()),
+					Conversions::Name<TDimension>(),
+					static_cast<unsigned char>(alias.second)
+				});
+				
+				_pool += alias.first;
+			}
+		}
+		
+		/*
+		 * Myers' bit-parallel edit distance, in Hyyrö's formulation. Bit i of VP (VN) is set where the distance
+		 * increases (decreases) from row i to row i + 1 of the current column, and the score tracks the last row.
+		 * Returns _limit + 1 as soon as the distance is known to exceed _limit.
+		 */
+		[[nodiscard]] static size_t Distance(const std::array<uint64_t, 256U>& _peq, const size_t& _length, const std::string_view& _text, const size_t& _limit) noexcept {
+			
+			const auto top = uint64_t(1U) << (_length - 1U);
+			
+			uint64_t vp = _length == 64U ? ~uint64_t(0U) : (uint64_t(1U) << _length) - 1U;
+			uint64_t vn = 0U;
+			
+			auto score = _length;
+			
+			for (size_t j = 0U; j < _text.size(); ++j) {
+				
+				const auto eq = _peq[static_cast<unsigned char>(_text[j])];
+				
+				const auto x  = eq | vn;
+				const auto d0 = (((x & vp) + vp) ^ vp) | x;
+				
+				auto hp = vn | ~(d0 | vp);
+				auto hn = vp & d0;
+				
+				score += (hp & top) != 0U ? 1U : 0U;
+				score -= (hn & top) != 0U ? 1U : 0U;
+				
+				// The first row of the matrix is the column index, so it always increases.
+				hp = (hp << 1U) | 1U;
+				hn =  hn << 1U;
+				
+				vp = hn | ~(d0 | hp);
+				vn = hp & d0;
+				
+				// The score can fall by at most one for each remaining character.
+				if (score > _limit + (_text.size() - j - 1U)) {
+					return _limit + 1U;
+				}
+			}
+			
+			return score;
+		}
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_FUZZY_MATCHER_HPP
@@ -0,0 +1,193 @@
+#ifndef LOUIERIKSSON_HISTOGRAM_HPP
+#define LOUIERIKSSON_HISTOGRAM_HPP
+
+#include "Conversions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @class Histogram
+	 * @brief A histogram with bin edges in one unit, which bins data stored in any unit of the same dimension.
+	 *
+	 * @details Rather than converting every sample into the unit of the edges, the edges are converted once into
+	 * the unit of the samples. Every conversion is monotonic (including the affine conversions of Temperature), so
+	 * a sample falls into the same bin either way. The converted edge sets are cached per source unit, so data in
+	 * mixed units is binned without converting any sample.
+	 *
+	 * There are Edges().size() + 1 bins. Bin 0 counts values below the first edge, bin i counts values in
+	 * [edge i - 1, edge i), and the last bin counts values at or above the last edge. NaN values are not counted.
+	 *
+	 * @note Converted edges are rounded to T, so a value within rounding error of an edge may fall into the
+	 * neighbouring bin.
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * Histogram<Conversions::Speed> histogram({ 0.0, 10.0, 20.0, 30.0 }, Conversions::Speed::MetreSecond);
+	 *
+	 * histogram.Add(samples_kmh.data(), samples_kmh.size(), Conversions::Speed::KilometreHour);
+	 * histogram.Add(samples_mph.data(), samples_mph.size(), Conversions::Speed::MileHour);
+	 * @endcode
+	 */
+	template<typename TDimension, typename T = double>
+	class Histogram final {
+		
+		static_assert(std::is_floating_point_v<T>, "Histogram values must be of a floating-point type.");
+	
+	public:
+		
+		using dimension_t = TDimension;
+		using value_t     = T;
+		using unit_t      = typename TDimension::Unit;
+		
+		/**
+		 * @brief Creates an empty histogram.
+		 *
+		 * @param[in] _edges The bin edges, in strictly increasing order.
+		 * @param[in] _unit The unit of the bin edges.
+		 */
+		Histogram(std::vector<T> _edges, const unit_t& _unit) :
+			m_Unit(_unit),
+			m_Counts(_edges.size() + 1U, 0U)
+		{
+			if (_edges.empty()) {
+				throw std::invalid_argument("A histogram requires at least one edge.");
+			}
+			
+			for (size_t i = 1U; i < _edges.size(); ++i) {
+				
+				if (!(_edges[i - 1U] < _edges[i])) {
+					throw std::invalid_argument("Histogram edges must be strictly increasing.");
+				}
+			}
+			
+			m_Edges[m_Unit] = std::move(_edges);
+		}
+		
+		/** @brief Returns the bin edges, in the unit of the histogram. */
+		[[nodiscard]] const std::vector<T>& Edges() const noexcept { return m_Edges[m_Unit]; }
+		
+		/** @brief Returns the unit of the bin edges. */
+		[[nodiscard]] const unit_t& Unit() const noexcept { return m_Unit; }
+		
+		/** @brief Returns the count of every bin. */
+		[[nodiscard]] const std::vector<uint64_t>& Counts() const noexcept { return m_Counts; }
+		
+		/**
+		 * @brief Bins values stored in a single unit.
+		 *
+		 * @param[in] _data Pointer to the first value.
+		 * @param[in] _size The number of values.
+		 * @param[in] _unit The unit the values are stored in.
+		 */
+		void Add(const T* _data, const size_t& _size, const unit_t& _unit) {
+			
+			const auto& edges = EdgesIn(_unit);
+			
+			for (size_t i = 0U; i < _size; ++i) {
+				
+				if (_data[i] == _data[i]) {
+					++m_Counts[Bin(edges, _data[i])];
+				}
+			}
+		}
+		
+		/**
+		 * @brief Bins values stored in mixed units.
+		 *
+		 * @param[in] _data Pointer to the first value.
+		 * @param[in] _units Pointer to the unit of the first value.
+		 * @param[in] _size The number of values (and units).
+		 */
+		void Add(const T* _data, const unit_t* _units, const size_t& _size) {
+			
+			for (size_t i = 0U; i < _size; ++i) {
+				
+				if (_data[i] == _data[i]) {
+					++m_Counts[Bin(EdgesIn(_units[i]), _data[i])];
+				}
+			}
+		}
+		
+		/** @brief Resets the count of every bin to zero. */
+		void Clear() noexcept {
+			std::fill(m_Counts.begin(), m_Counts.end(), 0U);
+		}
+	
+	private:
+		
+		/* Below this many edges, counting the edges a value exceeds is faster than a binary search. */
+		static constexpr size_t s_LinearSearchLimit = 32U;
+		
+		unit_t m_Unit;
+		
+		std::vector<uint64_t> m_Counts;
+		
+		/** @brief The edges converted into each unit, populated on first use. */
+		std::array<std::vector<T>, TDimension::s_Count> m_Edges;
+		
+		const std::vector<T>& EdgesIn(const unit_t& _unit) {
+			
+			auto& result = m_Edges[_unit];
+			
+			if (result.empty()) {
+				
+				const auto& edges = m_Edges[m_Unit];
+				const auto  plan  = Conversions::Plan::Make<TDimension>(m_Unit, _unit);
+				
+				result.reserve(edges.size());
+				
+				for (const auto& edge : edges) {
+					result.emplace_back(plan(edge));
+				}
+			}
+			
+			return result;
+		}
+		
+		/*
+		 * Both searches are branchless: the linear search vectorises across the edges, and the binary search
+		 * compiles to conditional moves, so neither mispredicts on noisy data.
+		 */
+		[[nodiscard]] static size_t Bin(const std::vector<T>& _edges, const T& _value) noexcept {
+			
+			const auto* edges = _edges.data();
+			auto        size  = _edges.size();
+			
+			if (size <= s_LinearSearchLimit) {
+				
+				size_t result = 0U;
+				
+				for (size_t i = 0U; i < size; ++i) {
+					result += _value >= edges[i] ? 1U : 0U;
+				}
+				
+				return result;
+			}
+			
+			const auto* base = edges;
+			
+			while (size > 1U) {
+				
+				const auto half = size / 2U;
+				
+				base  = base[half] <= _value ? base + half : base;
+				size -= half;
+			}
+			
+			return static_cast<size_t>(base - edges) + (*base <= _value ? 1U : 0U);
+		}
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_HISTOGRAM_HPP
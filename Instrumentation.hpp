@@ -0,0 +1,455 @@
+#ifndef LOUIERIKSSON_INSTRUMENTATION_HPP
+#define LOUIERIKSSON_INSTRUMENTATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+	#include <intrin.h>
+#endif
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @struct Instrumentation
+	 * @brief Latency histograms of symbol lookup, plan creation and batch conversion, recorded from inside the library.
+	 *
+	 * @details Defining LOUIERIKSSON_MATHS_INSTRUMENTATION includes this header from Conversions.hpp and times:
+	 *
+	 * - Lookup: the TryGuessUnit of every dimension.
+	 * - Plan: Conversions::Plan::Make, when called at runtime.
+	 * - Batch: the batch kernels of Columns, Arrow, Parsing (ParseColumn) and Expressions (Evaluate).
+	 *
+	 * Every lookup (as a hit or a miss), plan and batch (with its size) is also counted per dimension (see Counters).
+	 * Without the definition, nothing is recorded and the library is unchanged.
+	 *
+	 * Only one call in every SamplePeriod() on each thread is timed, so a call which is not sampled costs a
+	 * decrement of a thread-local counter. A sampled call reads the time stamp counter (rdtsc) on x86, or the steady
+	 * clock elsewhere, before and after, and increments one bucket of a high-dynamic-range histogram with a relaxed
+	 * atomic add. No call ever waits on a lock.
+	 *
+	 * The histograms have 128 linear sub-buckets per power of two, so any value is recorded to within 1/128 (0.8%)
+	 * of itself, from a single tick up to 2^40 ticks (around six minutes at 3 GHz), beyond which values are clamped.
+	 * Snapshots are taken without stopping writers, and report quantiles in nanoseconds.
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * const auto lookups = Instrumentation::Latency(Instrumentation::Lookup);
+	 *
+	 * std::printf("p99: %.0f ns, p99.9: %.0f ns\n", lookups.Quantile(0.99), lookups.Quantile(0.999));
+	 * @endcode
+	 *
+	 * @note Time stamp counter readings are converted to nanoseconds by comparing them with the steady clock, which
+	 * assumes an invariant time stamp counter (as on every x86 processor of the last decade).
+	 */
+	struct Instrumentation final {
+		
+		/** @brief An instrumented operation. */
+		enum Operation : unsigned char {
+			Lookup,
+			Plan,
+			Batch,
+		};
+		
+		/** @brief The number of instrumented operations. */
+		static constexpr size_t s_Operations = Batch + 1U;
+		
+		/** @brief The number of linear sub-buckets per power of two, as a power of two. */
+		static constexpr unsigned s_SubBucketBits = 7U;
+		
+		/** @brief The number of bits of the largest value recorded. */
+		static constexpr unsigned s_ValueBits = 40U;
+		
+		/** @brief The number of buckets of a histogram. */
+		static constexpr size_t s_Buckets = size_t(s_ValueBits - s_SubBucketBits + 1U) << s_SubBucketBits;
+		
+		/**
+		 * @class Snapshot
+		 * @brief A copy of a latency histogram, in which values are reported in nanoseconds.
+		 *
+		 * @details Each bucket is read atomically, but not all at the same instant, so calls which complete while the
+		 * snapshot is taken may or may not be included. The counts of a later snapshot are never less than those of
+		 * an earlier one.
+		 */
+		class Snapshot final {
+			
+			friend Instrumentation;
+		
+		public:
+			
+			/** @brief Returns the number of calls recorded. */
+			[[nodiscard]] uint64_t Count() const noexcept { return m_Count; }
+			
+			/**
+			 * @brief Estimates a quantile of the recorded latencies.
+			 *
+			 * @param[in] _q The quantile, in [0, 1].
+			 * @return The latency in nanoseconds, or 0 if nothing was recorded.
+			 */
+			[[nodiscard]] double Quantile(const double& _q) const {
+				
+				if (!(_q >= 0.0 && _q <= 1.0)) {
+					throw std::domain_error("Quantile must be within [0, 1].");
+				}
+				
+				// The nearest rank: the smallest value which is at least the given fraction of the recorded values.
+				const auto rank = std::min(m_Count, std::max<uint64_t>(1U, static_cast<uint64_t>(std::ceil(_q * static_cast<double>(m_Count)))));
+				
+				uint64_t seen = 0U;
+				
+				for (size_t i = 0U; i < s_Buckets; ++i) {
+					
+					if ((seen += m_Counts[i]) >= rank && m_Counts[i] != 0U) {
+						return Midpoint(i) * m_NanosecondsPerTick;
+					}
+				}
+				
+				return 0.0;
+			}
+			
+			/** @brief Returns the mean of the recorded latencies in nanoseconds, or 0 if nothing was recorded. */
+			[[nodiscard]] double Mean() const noexcept {
+				
+				double sum = 0.0;
+				
+				for (size_t i = 0U; i < s_Buckets; ++i) {
+					sum += static_cast<double>(m_Counts[i]) * Midpoint(i);
+				}
+				
+				return m_Count == 0U ? 0.0 : (sum / static_cast<double>(m_Count)) * m_NanosecondsPerTick;
+			}
+			
+			/** @brief Returns the largest recorded latency in nanoseconds, or 0 if nothing was recorded. */
+			[[nodiscard]] double Max() const noexcept { return m_Count == 0U ? 0.0 : Quantile(1.0); }
+			
+			/**
+			 * @brief Returns the latencies recorded after an earlier snapshot of the same histogram, such as to report
+			 * the distribution of each interval between scrapes.
+			 */
+			[[nodiscard]] Snapshot Since(const Snapshot& _earlier) const noexcept {
+				
+				Snapshot result = *this;
+				
+				for (size_t i = 0U; i < s_Buckets; ++i) {
+					result.m_Counts[i] -= _earlier.m_Counts[i];
+				}
+				
+				result.m_Count -= _earlier.m_Count;
+				
+				return result;
+			}
+		
+		private:
+			
+			std::array<uint64_t, s_Buckets> m_Counts;
+			
+			uint64_t m_Count;
+			
+			double m_NanosecondsPerTick;
+			
+			[[nodiscard]] static double Midpoint(const size_t& _bucket) noexcept {
+				
+				if (_bucket < (size_t(2U) << s_SubBucketBits)) {
+					return static_cast<double>(_bucket);
+				}
+				
+				const auto shift = static_cast<unsigned>(_bucket >> s_SubBucketBits) - 1U;
+				const auto lower = static_cast<uint64_t>(_bucket - (size_t(shift) << s_SubBucketBits)) << shift;
+				
+				return static_cast<double>(lower) + (static_cast<double>(uint64_t(1U) << shift) * 0.5);
+			}
+		};
+		
+		/**
+		 * @brief Times one call in every _period on each thread. One times every call, and zero disables timing.
+		 *
+		 * @details The default is 64. Each thread picks up a change when it next takes a sample.
+		 */
+		static void SamplePeriod(const uint32_t& _period) noexcept { s_Period.store(_period, std::memory_order_relaxed); }
+		
+		/** @brief Returns the sampling period. */
+		[[nodiscard]] static uint32_t SamplePeriod() noexcept { return s_Period.load(std::memory_order_relaxed); }
+		
+		/**
+		 * @brief Takes a snapshot of the latency histogram of an operation.
+		 *
+		 * @param[in] _operation The operation.
+		 * @return The snapshot.
+		 *
+		 * @note The first snapshot of a process may wait for up to 10 ms to calibrate the time stamp counter.
+		 */
+		[[nodiscard]] static Snapshot Latency(const Operation& _operation) {
+			
+			Snapshot result;
+			result.m_Count              = 0U;
+			result.m_NanosecondsPerTick = NanosecondsPerTick();
+			
+			const auto& histogram = s_Histograms[_operation];
+			
+			for (size_t i = 0U; i < s_Buckets; ++i) {
+				result.m_Count += (result.m_Counts[i] = histogram[i].load(std::memory_order_relaxed));
+			}
+			
+			return result;
+		}
+		
+		/**
+		 * @brief Starts timing a call, if it is to be sampled.
+		 *
+		 * @return The time at which the call started, or zero if it is not sampled.
+		 */
+		[[nodiscard]] static uint64_t Begin() noexcept {
+			
+			if (t_Countdown > 1U) {
+				--t_Countdown;
+				return 0U;
+			}
+			
+			// While disabled, the period is checked again every 65536 calls.
+			const auto period = s_Period.load(std::memory_order_relaxed);
+			t_Countdown = period == 0U ? 65536U : period;
+			
+			return period == 0U ? 0U : Ticks();
+		}
+		
+		/**
+		 * @brief Finishes timing a call.
+		 *
+		 * @param[in] _operation The operation which was called.
+		 * @param[in] _begin The value returned by Begin(). Nothing is recorded if it is zero.
+		 */
+		static void End(const Operation& _operation, const uint64_t& _begin) noexcept {
+			
+			if (_begin != 0U) {
+				s_Histograms[_operation][Bucket(Ticks() - _begin)].fetch_add(1U, std::memory_order_relaxed);
+			}
+		}
+		
+		/**
+		 * @class Scope
+		 * @brief Times the enclosing scope, if it is sampled.
+		 */
+		class Scope final {
+		
+		public:
+			
+			explicit Scope(const Operation& _operation) noexcept :
+				m_Operation(_operation),
+				m_Begin(Begin()) {}
+			
+			~Scope() { End(m_Operation, m_Begin); }
+			
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+		
+		private:
+			
+			Operation m_Operation;
+			
+			uint64_t m_Begin;
+		};
+		
+		/** @brief The number of buckets of batch sizes: one per power of four up to 4^10, and one for larger batches. */
+		static constexpr size_t s_BatchBuckets = 12U;
+		
+		/** @brief The number of cache lines over which the counts of each dimension are spread. */
+		static constexpr size_t s_Shards = 16U;
+		
+		/**
+		 * @struct Totals
+		 * @brief The counts of the calls for one dimension, summed over every thread.
+		 */
+		struct Totals final {
+			
+			uint64_t m_Hits;
+			uint64_t m_Misses;
+			uint64_t m_Plans;
+			uint64_t m_Batches;
+			
+			/** @brief The total number of values of every batch. */
+			uint64_t m_BatchValues;
+			
+			/** @brief The number of batches of each size, where bucket i holds sizes in (4^(i-1), 4^i]. */
+			std::array<uint64_t, s_BatchBuckets> m_BatchSizes;
+		};
+		
+		/**
+		 * @class Counters
+		 * @brief Exact counts of the lookups, plans and batches of one dimension, or, for void, of the batches whose
+		 * dimension is not known (ParseColumn, which is given only a Plan).
+		 *
+		 * @details Unlike latencies, every call is counted. Threads are assigned in turn to one of s_Shards cache
+		 * lines, so that a count is a relaxed atomic add to a line which is rarely shared with another thread.
+		 */
+		template<typename TDimension>
+		class Counters final {
+		
+		public:
+			
+			static void CountLookup(const bool& _hit) noexcept {
+				
+				auto& shard = s_Counts[Shard()];
+				
+				(_hit ? shard.m_Hits : shard.m_Misses).fetch_add(1U, std::memory_order_relaxed);
+			}
+			
+			static void CountPlan() noexcept {
+				s_Counts[Shard()].m_Plans.fetch_add(1U, std::memory_order_relaxed);
+			}
+			
+			static void CountBatch(const size_t& _size) noexcept {
+				
+				auto& shard = s_Counts[Shard()];
+				
+				const auto bucket = _size <= 1U ? 0U : std::min<size_t>((Log2(_size - 1U) / 2U) + 1U, s_BatchBuckets - 1U);
+				
+				shard.m_Batches.fetch_add(1U, std::memory_order_relaxed);
+				shard.m_BatchValues.fetch_add(_size, std::memory_order_relaxed);
+				shard.m_BatchSizes[bucket].fetch_add(1U, std::memory_order_relaxed);
+			}
+			
+			/** @brief Sums the counts of every thread, without stopping them. */
+			[[nodiscard]] static Totals Read() noexcept {
+				
+				Totals result{};
+				
+				for (const auto& shard : s_Counts) {
+					
+					result.m_Hits        += shard.m_Hits       .load(std::memory_order_relaxed);
+					result.m_Misses      += shard.m_Misses     .load(std::memory_order_relaxed);
+					result.m_Plans       += shard.m_Plans      .load(std::memory_order_relaxed);
+					result.m_Batches     += shard.m_Batches    .load(std::memory_order_relaxed);
+					result.m_BatchValues += shard.m_BatchValues.load(std::memory_order_relaxed);
+					
+					for (size_t i = 0U; i < s_BatchBuckets; ++i) {
+						result.m_BatchSizes[i] += shard.m_BatchSizes[i].load(std::memory_order_relaxed);
+					}
+				}
+				
+				return result;
+			}
+		
+		private:
+			
+			struct alignas(64) Line final {
+				
+				std::atomic<uint64_t> m_Hits;
+				std::atomic<uint64_t> m_Misses;
+				std::atomic<uint64_t> m_Plans;
+				std::atomic<uint64_t> m_Batches;
+				std::atomic<uint64_t> m_BatchValues;
+				
+				std::array<std::atomic<uint64_t>, s_BatchBuckets> m_BatchSizes;
+			};
+			
+			inline static std::array<Line, s_Shards> s_Counts{};
+		};
+		
+		/** @brief Reads the time stamp counter, or the steady clock in nanoseconds where there is none. */
+		[[nodiscard]] static uint64_t Ticks() noexcept {
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+			return __rdtsc();
+#else
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+		}
+		
+		/** @brief Returns the index of the bucket which records a value. */
+		[[nodiscard]] static size_t Bucket(uint64_t _ticks) noexcept {
+			
+			_ticks = _ticks < (uint64_t(1U) << s_ValueBits) ? _ticks : (uint64_t(1U) << s_ValueBits) - 1U;
+			
+			if (_ticks < (uint64_t(2U) << s_SubBucketBits)) {
+				return static_cast<size_t>(_ticks);
+			}
+			
+			const auto shift = Log2(_ticks) - s_SubBucketBits;
+			
+			return (size_t(shift) << s_SubBucketBits) + static_cast<size_t>(_ticks >> shift);
+		}
+	
+	private:
+		
+		/** @brief A time stamp counter reading and the steady clock at the same instant. */
+		struct Origin final {
+			
+			uint64_t m_Ticks;
+			
+			std::chrono::steady_clock::time_point m_Time;
+		};
+		
+		inline static std::array<std::array<std::atomic<uint64_t>, s_Buckets>, s_Operations> s_Histograms{};
+		
+		inline static std::atomic<uint32_t> s_Period { 64U };
+		
+		inline static thread_local uint32_t t_Countdown { 0U };
+		
+		inline static const Origin s_Origin { Ticks(), std::chrono::steady_clock::now() };
+		
+		inline static std::atomic<size_t> s_NextShard { 0U };
+		
+		inline static thread_local size_t t_Shard { s_Shards };
+		
+		/** @brief Returns the shard of the calling thread, assigning one on its first call. */
+		[[nodiscard]] static size_t Shard() noexcept {
+			
+			if (t_Shard == s_Shards) {
+				t_Shard = s_NextShard.fetch_add(1U, std::memory_order_relaxed) % s_Shards;
+			}
+			
+			return t_Shard;
+		}
+		
+		[[nodiscard]] static unsigned Log2(const uint64_t& _value) noexcept {
+
+#if defined(__GNUC__) || defined(__clang__)
+			return 63U - static_cast<unsigned>(__builtin_clzll(_value));
+#else
+			unsigned result = 0U;
+			
+			for (auto value = _value; value > 1U; value >>= 1U) {
+				++result;
+			}
+			
+			return result;
+#endif
+		}
+		
+		/** @brief Measures the rate of the time stamp counter against the steady clock, over at least 10 ms. */
+		[[nodiscard]] static double NanosecondsPerTick() {
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+			
+			for (;;) {
+				
+				const auto ticks = Ticks();
+				const auto time  = std::chrono::steady_clock::now();
+				
+				const auto elapsed = std::chrono::duration<double, std::nano>(time - s_Origin.m_Time).count();
+				
+				if (elapsed >= 1e7) {
+					return elapsed / static_cast<double>(ticks - s_Origin.m_Ticks);
+				}
+				
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+#else
+			return 1.0;
+#endif
+		}
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_INSTRUMENTATION_HPP
@@ -0,0 +1,294 @@
+#ifndef LOUIERIKSSON_MISS_LOG_HPP
+#define LOUIERIKSSON_MISS_LOG_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @struct MissLog
+	 * @brief A log of the symbols which TryGuessUnit did not recognise, for finding the aliases which are missing.
+	 *
+	 * @details Defining LOUIERIKSSON_MATHS_MISS_LOG includes this header from Conversions.hpp, and passes every miss
+	 * of the TryGuessUnit of any dimension to Record. A hit costs only the test of the result which it already
+	 * returns. Of the misses on each thread, one in SamplePeriod() on average is hashed with its dimension, and is logged
+	 * unless the same hash was logged before, so each unrecognised symbol is logged once however often it recurs.
+	 *
+	 * Logged misses go into a bounded lock-free queue (Vyukov's), from which any thread, typically a background
+	 * thread which forwards them to the application's logger, drains them with Drain. When the queue is full,
+	 * misses are dropped rather than waited for, and counted (see Dropped).
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * std::thread drainer([&]() {
+	 *
+	 *     while (running) {
+	 *
+	 *         MissLog::Drain([](const MissLog::Miss& _miss) {
+	 *             std::fprintf(stderr, "Unrecognised %s symbol \"%.*s\"\n", _miss.m_Dimension, int(_miss.Symbol().size()), _miss.Symbol().data());
+	 *         });
+	 *
+	 *         std::this_thread::sleep_for(std::chrono::seconds(1));
+	 *     }
+	 * });
+	 * @endcode
+	 *
+	 * @note The deduplication table remembers the hashes of several thousand symbols. A symbol which is evicted from
+	 * it by others is logged again when it next recurs.
+	 */
+	struct MissLog final {
+		
+		/** @brief The number of characters of a symbol which are kept. Longer symbols are truncated. */
+		static constexpr size_t s_SymbolCapacity = 47U;
+		
+		/** @brief The number of misses the queue holds. */
+		static constexpr size_t s_Capacity = 1024U;
+		
+		/** @brief The number of hashes remembered to deduplicate misses, in sets of eight (one cache line). */
+		static constexpr size_t s_Hashes = 8192U;
+		
+		/** @brief A symbol which was not recognised. */
+		struct Miss final {
+			
+			/** @brief The name of the dimension whose TryGuessUnit was called. */
+			const char* m_Dimension;
+			
+			/** @brief The hash of the dimension and the symbol. */
+			uint64_t m_Hash;
+			
+			/** @brief The length of the symbol, which may exceed that of the kept characters. */
+			uint32_t m_Length;
+			
+			char m_Symbol[s_SymbolCapacity];
+			
+			/** @brief Returns the kept characters of the symbol. */
+			[[nodiscard]] std::string_view Symbol() const noexcept {
+				return { m_Symbol, std::min<size_t>(m_Length, s_SymbolCapacity) };
+			}
+		};
+		
+		/**
+		 * @brief Considers one miss in every _period on each thread, on average. One considers every miss, and zero
+		 * disables logging.
+		 *
+		 * @details The default is 8. Each thread picks up a change when it next considers a miss.
+		 */
+		static void SamplePeriod(const uint32_t& _period) noexcept { s_Period.store(_period, std::memory_order_relaxed); }
+		
+		/** @brief Returns the sampling period. */
+		[[nodiscard]] static uint32_t SamplePeriod() noexcept { return s_Period.load(std::memory_order_relaxed); }
+		
+		/** @brief Returns the number of misses which were dropped as the queue was full. */
+		[[nodiscard]] static uint64_t Dropped() noexcept { return s_Dropped.load(std::memory_order_relaxed); }
+		
+		/**
+		 * @brief Considers a miss for the log.
+		 *
+		 * @param[in] _dimension The name of the dimension. Must outlive the log, such as a string literal.
+		 * @param[in] _symbol The symbol which was not recognised.
+		 */
+		static void Record(const char* _dimension, const std::string_view& _symbol) noexcept {
+			
+			if (t_Countdown > 1U) {
+				--t_Countdown;
+				return;
+			}
+			
+			const auto period = s_Period.load(std::memory_order_relaxed);
+			
+			// While disabled, the period is checked again every 65536 misses.
+			if (period == 0U) {
+				t_Countdown = 65536U;
+				return;
+			}
+			
+			// The interval is random, with a mean of the period, so that it cannot alias with a periodic pattern of calls.
+			t_Random ^= t_Random << 13U;
+			t_Random ^= t_Random >> 17U;
+			t_Random ^= t_Random << 5U;
+			t_Countdown = 1U + static_cast<uint32_t>((static_cast<uint64_t>(t_Random) * ((uint64_t(period) * 2U) - 1U)) >> 32U);
+			
+			const auto hash = Hash(_dimension, _symbol);
+			
+			auto* set = &s_Seen[(hash & ((s_Hashes / 8U) - 1U)) * 8U];
+			
+			if (!Remember(set, hash)) {
+				return;
+			}
+			
+			Miss miss;
+			miss.m_Dimension = _dimension;
+			miss.m_Hash      = hash;
+			miss.m_Length    = static_cast<uint32_t>(std::min<size_t>(_symbol.size(), std::numeric_limits<uint32_t>::max()));
+			std::memcpy(miss.m_Symbol, _symbol.data(), std::min(_symbol.size(), s_SymbolCapacity));
+			
+			if (!TryPush(miss)) {
+				
+				s_Dropped.fetch_add(1U, std::memory_order_relaxed);
+				
+				// Forget it, so that it is logged when it next recurs.
+				for (size_t i = 0U; i < 8U; ++i) {
+					
+					auto expected = hash;
+					set[i].compare_exchange_strong(expected, 0U, std::memory_order_relaxed);
+				}
+			}
+		}
+		
+		/**
+		 * @brief Removes every miss in the queue, passing each to a function.
+		 *
+		 * @param[in] _function Called with each miss, as `_function(const Miss&)`.
+		 * @return The number of misses removed.
+		 */
+		template<typename TFunction>
+		static size_t Drain(const TFunction& _function) {
+			
+			size_t result = 0U;
+			
+			for (Miss miss; TryPop(miss); ++result) {
+				_function(miss);
+			}
+			
+			return result;
+		}
+	
+	private:
+		
+		/**
+		 * A slot of the queue. Its sequence is stored relative to its index, so that the zero-initialised queue is
+		 * empty without being constructed.
+		 */
+		struct Cell final {
+			
+			std::atomic<size_t> m_Sequence;
+			
+			Miss m_Miss;
+		};
+		
+		inline static std::array<Cell, s_Capacity> s_Cells{};
+		
+		alignas(64) inline static std::atomic<size_t> s_Head { 0U };
+		alignas(64) inline static std::atomic<size_t> s_Tail { 0U };
+		
+		alignas(64) inline static std::array<std::atomic<uint64_t>, s_Hashes> s_Seen{};
+		
+		inline static std::atomic<uint32_t> s_Period  { 8U };
+		inline static std::atomic<uint64_t> s_Dropped { 0U };
+		
+		inline static thread_local uint32_t t_Countdown { 0U };
+		inline static thread_local uint32_t t_Random    { 0x9E3779B9U };
+		
+		/**
+		 * @brief Adds a hash to its set of the deduplication table, returning false if it was already there. A full set
+		 * evicts the entry chosen by the upper bits of the hash.
+		 */
+		[[nodiscard]] static bool Remember(std::atomic<uint64_t>* _set, const uint64_t& _hash) noexcept {
+			
+			for (size_t i = 0U; i < 8U; ++i) {
+				
+				if (_set[i].load(std::memory_order_relaxed) == _hash) {
+					return false;
+				}
+			}
+			
+			for (size_t i = 0U; i < 8U; ++i) {
+				
+				uint64_t expected = 0U;
+				
+				if (_set[i].compare_exchange_strong(expected, _hash, std::memory_order_relaxed)) {
+					return true;
+				}
+				
+				if (expected == _hash) {
+					return false;
+				}
+			}
+			
+			return _set[_hash >> 61U].exchange(_hash, std::memory_order_relaxed) != _hash;
+		}
+		
+		/** @brief FNV-1a over the symbol, seeded with the dimension. Never zero, which marks an empty slot. */
+		[[nodiscard]] static uint64_t Hash(const char* _dimension, const std::string_view& _symbol) noexcept {
+			
+			auto result = 0xCBF29CE484222325ULL ^ static_cast<uint64_t>(reinterpret_cast<uintptr_t>(_dimension));
+			
+			for (const auto& c : _symbol) {
+				result = (result ^ static_cast<unsigned char>(c)) * 0x100000001B3ULL;
+			}
+			
+			return result == 0U ? 1U : result;
+		}
+		
+		[[nodiscard]] static bool TryPush(const Miss& _miss) noexcept {
+			
+			auto position = s_Tail.load(std::memory_order_relaxed);
+			
+			for (;;) {
+				
+				auto& cell = s_Cells[position & (s_Capacity - 1U)];
+				
+				const auto sequence = cell.m_Sequence.load(std::memory_order_acquire) + (position & (s_Capacity - 1U));
+				const auto distance = static_cast<std::ptrdiff_t>(sequence - position);
+				
+				if (distance == 0) {
+					
+					if (s_Tail.compare_exchange_weak(position, position + 1U, std::memory_order_relaxed)) {
+						
+						cell.m_Miss = _miss;
+						cell.m_Sequence.store((position + 1U) - (position & (s_Capacity - 1U)), std::memory_order_release);
+						
+						return true;
+					}
+				}
+				else if (distance < 0) {
+					return false;
+				}
+				else {
+					position = s_Tail.load(std::memory_order_relaxed);
+				}
+			}
+		}
+		
+		[[nodiscard]] static bool TryPop(Miss& _miss) noexcept {
+			
+			auto position = s_Head.load(std::memory_order_relaxed);
+			
+			for (;;) {
+				
+				auto& cell = s_Cells[position & (s_Capacity - 1U)];
+				
+				const auto sequence = cell.m_Sequence.load(std::memory_order_acquire) + (position & (s_Capacity - 1U));
+				const auto distance = static_cast<std::ptrdiff_t>(sequence - (position + 1U));
+				
+				if (distance == 0) {
+					
+					if (s_Head.compare_exchange_weak(position, position + 1U, std::memory_order_relaxed)) {
+						
+						_miss = cell.m_Miss;
+						cell.m_Sequence.store((position + s_Capacity) - (position & (s_Capacity - 1U)), std::memory_order_release);
+						
+						return true;
+					}
+				}
+				else if (distance < 0) {
+					return false;
+				}
+				else {
+					position = s_Head.load(std::memory_order_relaxed);
+				}
+			}
+		}
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_MISS_LOG_HPP
@@ -0,0 +1,379 @@
+#ifndef LOUIERIKSSON_PREFIXES_HPP
+#define LOUIERIKSSON_PREFIXES_HPP
+
+#include "Conversions.hpp"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @struct Prefixes
+	 * @brief Resolution of symbols formed from any SI prefix (quecto to quetta) and a base symbol of a dimension.
+	 *
+	 * @details The lookup tables of Conversions list only the prefixed forms in common use, such as `km`, `hPa` and
+	 * `ms`. TryGuessUnit falls back to stripping a prefix from the symbol and matching the remainder against the
+	 * base symbols of the dimension, so that unlisted forms such as `GPa`, `µm` or `Mg` resolve to a unit of the
+	 * dimension and a power of ten. The fallback is a switch on the first byte and a comparison against a handful
+	 * of base symbols, so costs little more than the failed lookup which precedes it.
+	 *
+	 * Prefixes of squared and cubed bases are raised to the same power, so `km²` is 10⁶ m² and `dm³` is 10⁻³ m³.
+	 */
+	struct Prefixes final {
+		
+		using conversion_scalar_t = Conversions::conversion_scalar_t;
+		
+		/**
+		 * @struct Resolved
+		 * @brief A unit of a dimension, scaled by the power of ten given by a prefix.
+		 *
+		 * @details A value in the resolved symbol is equal to `_val * m_Factor` in m_Unit.
+		 */
+		template<typename TDimension>
+		struct Resolved final {
+			
+			typename TDimension::Unit m_Unit;
+			
+			conversion_scalar_t m_Factor { 1 };
+			
+			/**
+			 * @brief Resolves the conversion from this symbol to a unit of the dimension.
+			 *
+			 * @param[in] _to The unit to convert to.
+			 * @return A Plan which folds the prefix into its scale.
+			 */
+			[[nodiscard]] constexpr Conversions::Plan To(const typename TDimension::Unit& _to) const {
+				
+				auto result = Conversions::Plan::Make<TDimension>(m_Unit, _to);
+				result.m_Scale *= m_Factor;
+				
+				return result;
+			}
+			
+			/**
+			 * @brief Resolves the conversion from a unit of the dimension to this symbol.
+			 *
+			 * @param[in] _from The unit to convert from.
+			 * @return A Plan which folds the prefix into its scale and offset.
+			 */
+			[[nodiscard]] constexpr Conversions::Plan From(const typename TDimension::Unit& _from) const {
+				
+				auto result = Conversions::Plan::Make<TDimension>(_from, m_Unit);
+				result.m_Scale  /= m_Factor;
+				result.m_Offset /= m_Factor;
+				
+				return result;
+			}
+		};
+		
+		/**
+		 * @brief Tries to resolve a symbol, allowing any SI prefix on the base symbols of the dimension.
+		 *
+		 * @param[in] _symbol The symbol to resolve.
+		 * @return The unit and factor if the symbol is recognised, otherwise an empty optional.
+		 *
+		 * @note Symbols in the lookup table of the dimension take precedence, so `mm` is a millimetre and `min` is a
+		 * minute. `u` is accepted in place of `µ`, as is the Greek letter mu.
+		 *
+		 * @code
+		 * using namespace LouiEriksson::Maths;
+		 *
+		 * if (const auto gpa = Prefixes::TryGuessUnit<Conversions::Pressure>("GPa")) {
+		 *
+		 *     const auto plan = gpa->To(Conversions::Pressure::PoundSquareInch);
+		 *
+		 *     const auto psi = plan(2.5);
+		 * }
+		 * @endcode
+		 */
+		template<typename TDimension>
+		[[nodiscard]] static std::optional<Resolved<TDimension>> TryGuessUnit(const std::string_view& _symbol) {
+
+#if defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+			const Instrumentation::Scope scope(Instrumentation::Lookup);
+#endif
+			
+			const std::string symbol(_symbol);
+			
+			// The lookup is recorded once, as a miss only if the prefixed forms do not match either.
+			std::optional<Resolved<TDimension>> result;
+			
+			if (const auto unit = Conversions::Probe<TDimension>(symbol)) {
+				result = Resolved<TDimension> { unit.value().get(), 1 };
+			}
+			else {
+				result = TryStripPrefix<TDimension>(_symbol);
+			}
+			
+			Conversions::Record<TDimension>(symbol, result.has_value());
+			
+			return result;
+		}
+	
+	private:
+		
+		struct Prefix final {
+			
+			size_t m_Length;
+			int    m_Exponent;
+		};
+		
+		template<typename TDimension>
+		struct Base final {
+			
+			std::string_view          m_Symbol;
+			typename TDimension::Unit m_Unit;
+			int                       m_Power;
+			
+			/** @brief The smallest exponent of a prefix the symbol accepts. */
+			int m_MinExponent { -30 };
+		};
+		
+		/**
+		 * @brief The base symbols of a dimension which accept a prefix.
+		 *
+		 * @details Only symbols of coherent SI (or SI-accepted) units are listed, to avoid resolving nonsense such as
+		 * `kft`, or prefixing a symbol which is already prefixed. A base may also restrict the prefixes it accepts to
+		 * those of at least a given exponent, as the tonne accepts only multiples.
+		 */
+		template<typename TDimension>
+		struct Bases;
+		
+		/**
+		 * @brief Tries to resolve a symbol as a prefix followed by a base symbol of the dimension.
+		 *
+		 * @param[in] _symbol The symbol to resolve.
+		 * @return The unit and factor if the symbol is recognised, otherwise an empty optional.
+		 */
+		template<typename TDimension>
+		[[nodiscard]] static std::optional<Resolved<TDimension>> TryStripPrefix(const std::string_view& _symbol) {
+			
+			// "da" is the only prefix of two characters which is not a multi-byte encoding of a single one.
+			std::array<Prefix, 2U> candidates{};
+			size_t count = 0U;
+			
+			if (_symbol.size() > 2U && _symbol[0U] == 'd' && _symbol[1U] == 'a') {
+				candidates[count++] = { 2U, 1 };
+			}
+			
+			if (const auto prefix = Match(_symbol); prefix.m_Length != 0U) {
+				candidates[count++] = prefix;
+			}
+			
+			for (size_t i = 0U; i < count; ++i) {
+				
+				const auto base = _symbol.substr(candidates[i].m_Length);
+				
+				for (const auto& item : Bases<TDimension>::s_Items) {
+					
+					if (base == item.m_Symbol && candidates[i].m_Exponent >= item.m_MinExponent) {
+						return Resolved<TDimension> { item.m_Unit, PowerOfTen(candidates[i].m_Exponent * item.m_Power) };
+					}
+				}
+			}
+			
+			return std::nullopt;
+		}
+		
+		/**
+		 * @brief Matches the prefix of a symbol, excluding "da".
+		 *
+		 * @param[in] _symbol The symbol.
+		 * @return The length and exponent of the prefix, or a length of zero if the symbol does not begin with a
+		 * prefix followed by at least one character.
+		 */
+		[[nodiscard]] static constexpr Prefix Match(const std::string_view& _symbol) noexcept {
+			
+			Prefix result { 1U, 0 };
+			
+			if (_symbol.size() < 2U) {
+				return { 0U, 0 };
+			}
+			
+			switch (_symbol[0U]) {
+				case 'q': { result.m_Exponent = -30; break; }
+				case 'r': { result.m_Exponent = -27; break; }
+				case 'y': { result.m_Exponent = -24; break; }
+				case 'z': { result.m_Exponent = -21; break; }
+				case 'a': { result.m_Exponent = -18; break; }
+				case 'f': { result.m_Exponent = -15; break; }
+				case 'p': { result.m_Exponent = -12; break; }
+				case 'n': { result.m_Exponent =  -9; break; }
+				case 'u': { result.m_Exponent =  -6; break; }
+				case 'm': { result.m_Exponent =  -3; break; }
+				case 'c': { result.m_Exponent =  -2; break; }
+				case 'd': { result.m_Exponent =  -1; break; }
+				case 'h': { result.m_Exponent =   2; break; }
+				case 'k': { result.m_Exponent =   3; break; }
+				case 'M': { result.m_Exponent =   6; break; }
+				case 'G': { result.m_Exponent =   9; break; }
+				case 'T': { result.m_Exponent =  12; break; }
+				case 'P': { result.m_Exponent =  15; break; }
+				case 'E': { result.m_Exponent =  18; break; }
+				case 'Z': { result.m_Exponent =  21; break; }
+				case 'Y': { result.m_Exponent =  24; break; }
+				case 'R': { result.m_Exponent =  27; break; }
+				case 'Q': { result.m_Exponent =  30; break; }
+				case '\xC2': { // MICRO SIGN (U+00B5).
+					
+					if (_symbol.size() > 2U && _symbol[1U] == '\xB5') {
+						return { 2U, -6 };
+					}
+					
+					return { 0U, 0 };
+				}
+				case '\xCE': { // GREEK SMALL LETTER MU (U+03BC).
+					
+					if (_symbol.size() > 2U && _symbol[1U] == '\xBC') {
+						return { 2U, -6 };
+					}
+					
+					return { 0U, 0 };
+				}
+				default: {
+					return { 0U, 0 };
+				}
+			}
+			
+			return result;
+		}
+		
+		/**
+		 * @brief Returns 10 raised to an integer power, correctly rounded.
+		 *
+		 * @param[in] _exponent The exponent, which must be within [-90, 90] (a cubed quetta- or quecto- prefix).
+		 * @return The power of ten.
+		 */
+		[[nodiscard]] static conversion_scalar_t PowerOfTen(const int& _exponent) noexcept {
+			
+			/*
+			 * The literals are each correctly rounded, where repeated multiplication would accumulate error. They are
+			 * written in the precision of conversion_scalar_t, so that none is rounded twice.
+			 */
+			static constexpr std::array<conversion_scalar_t, 181U> s_Powers {
+
+#if defined(LOUIERIKSSON_MATHS_REPRODUCIBLE)
+				1e-90, 1e-89, 1e-88, 1e-87, 1e-86, 1e-85, 1e-84, 1e-83, 1e-82, 1e-81,
+				1e-80, 1e-79, 1e-78, 1e-77, 1e-76, 1e-75, 1e-74, 1e-73, 1e-72, 1e-71,
+				1e-70, 1e-69, 1e-68, 1e-67, 1e-66, 1e-65, 1e-64, 1e-63, 1e-62, 1e-61,
+				1e-60, 1e-59, 1e-58, 1e-57, 1e-56, 1e-55, 1e-54, 1e-53, 1e-52, 1e-51,
+				1e-50, 1e-49, 1e-48, 1e-47, 1e-46, 1e-45, 1e-44, 1e-43, 1e-42, 1e-41,
+				1e-40, 1e-39, 1e-38, 1e-37, 1e-36, 1e-35, 1e-34, 1e-33, 1e-32, 1e-31,
+				1e-30, 1e-29, 1e-28, 1e-27, 1e-26, 1e-25, 1e-24, 1e-23, 1e-22, 1e-21,
+				1e-20, 1e-19, 1e-18, 1e-17, 1e-16, 1e-15, 1e-14, 1e-13, 1e-12, 1e-11,
+				1e-10, 1e-9,  1e-8,  1e-7,  1e-6,  1e-5,  1e-4,  1e-3,  1e-2,  1e-1,
+				1e0,
+				1e1,   1e2,   1e3,   1e4,   1e5,   1e6,   1e7,   1e8,   1e9,   1e10,
+				1e11,  1e12,  1e13,  1e14,  1e15,  1e16,  1e17,  1e18,  1e19,  1e20,
+				1e21,  1e22,  1e23,  1e24,  1e25,  1e26,  1e27,  1e28,  1e29,  1e30,
+				1e31,  1e32,  1e33,  1e34,  1e35,  1e36,  1e37,  1e38,  1e39,  1e40,
+				1e41,  1e42,  1e43,  1e44,  1e45,  1e46,  1e47,  1e48,  1e49,  1e50,
+				1e51,  1e52,  1e53,  1e54,  1e55,  1e56,  1e57,  1e58,  1e59,  1e60,
+				1e61,  1e62,  1e63,  1e64,  1e65,  1e66,  1e67,  1e68,  1e69,  1e70,
+				1e71,  1e72,  1e73,  1e74,  1e75,  1e76,  1e77,  1e78,  1e79,  1e80,
+				1e81,  1e82,  1e83,  1e84,  1e85,  1e86,  1e87,  1e88,  1e89,  1e90,
+#else
+				1e-90L, 1e-89L, 1e-88L, 1e-87L, 1e-86L, 1e-85L, 1e-84L, 1e-83L, 1e-82L, 1e-81L,
+				1e-80L, 1e-79L, 1e-78L, 1e-77L, 1e-76L, 1e-75L, 1e-74L, 1e-73L, 1e-72L, 1e-71L,
+				1e-70L, 1e-69L, 1e-68L, 1e-67L, 1e-66L, 1e-65L, 1e-64L, 1e-63L, 1e-62L, 1e-61L,
+				1e-60L, 1e-59L, 1e-58L, 1e-57L, 1e-56L, 1e-55L, 1e-54L, 1e-53L, 1e-52L, 1e-51L,
+				1e-50L, 1e-49L, 1e-48L, 1e-47L, 1e-46L, 1e-45L, 1e-44L, 1e-43L, 1e-42L, 1e-41L,
+				1e-40L, 1e-39L, 1e-38L, 1e-37L, 1e-36L, 1e-35L, 1e-34L, 1e-33L, 1e-32L, 1e-31L,
+				1e-30L, 1e-29L, 1e-28L, 1e-27L, 1e-26L, 1e-25L, 1e-24L, 1e-23L, 1e-22L, 1e-21L,
+				1e-20L, 1e-19L, 1e-18L, 1e-17L, 1e-16L, 1e-15L, 1e-14L, 1e-13L, 1e-12L, 1e-11L,
+				1e-10L, 1e-9L,  1e-8L,  1e-7L,  1e-6L,  1e-5L,  1e-4L,  1e-3L,  1e-2L,  1e-1L,
+				1e0L,
+				1e1L,   1e2L,   1e3L,   1e4L,   1e5L,   1e6L,   1e7L,   1e8L,   1e9L,   1e10L,
+				1e11L,  1e12L,  1e13L,  1e14L,  1e15L,  1e16L,  1e17L,  1e18L,  1e19L,  1e20L,
+				1e21L,  1e22L,  1e23L,  1e24L,  1e25L,  1e26L,  1e27L,  1e28L,  1e29L,  1e30L,
+				1e31L,  1e32L,  1e33L,  1e34L,  1e35L,  1e36L,  1e37L,  1e38L,  1e39L,  1e40L,
+				1e41L,  1e42L,  1e43L,  1e44L,  1e45L,  1e46L,  1e47L,  1e48L,  1e49L,  1e50L,
+				1e51L,  1e52L,  1e53L,  1e54L,  1e55L,  1e56L,  1e57L,  1e58L,  1e59L,  1e60L,
+				1e61L,  1e62L,  1e63L,  1e64L,  1e65L,  1e66L,  1e67L,  1e68L,  1e69L,  1e70L,
+				1e71L,  1e72L,  1e73L,  1e74L,  1e75L,  1e76L,  1e77L,  1e78L,  1e79L,  1e80L,
+				1e81L,  1e82L,  1e83L,  1e84L,  1e85L,  1e86L,  1e87L,  1e88L,  1e89L,  1e90L,
+#endif
+			};
+			
+			return s_Powers[static_cast<size_t>(_exponent + 90)];
+		}
+	};
+	
+	template<> struct Prefixes::Bases<Conversions::Speed> {
+		
+		static constexpr std::array<Base<Conversions::Speed>, 1U> s_Items {{
+			{ "m/s", Conversions::Speed::MetreSecond, 1 },
+		}};
+	};
+	
+	template<> struct Prefixes::Bases<Conversions::Distance> {
+		
+		static constexpr std::array<Base<Conversions::Distance>, 1U> s_Items {{
+			{ "m", Conversions::Distance::Metre, 1 },
+		}};
+	};
+	
+	template<> struct Prefixes::Bases<Conversions::Rotation> {
+		
+		static constexpr std::array<Base<Conversions::Rotation>, 1U> s_Items {{
+			{ "rad", Conversions::Rotation::Radian, 1 },
+		}};
+	};
+	
+	template<> struct Prefixes::Bases<Conversions::Time> {
+		
+		static constexpr std::array<Base<Conversions::Time>, 1U> s_Items {{
+			{ "s", Conversions::Time::Second, 1 },
+		}};
+	};
+	
+	template<> struct Prefixes::Bases<Conversions::Temperature> {
+		
+		static constexpr std::array<Base<Conversions::Temperature>, 1U> s_Items {{
+			{ "K", Conversions::Temperature::Kelvin, 1 },
+		}};
+	};
+	
+	template<> struct Prefixes::Bases<Conversions::Pressure> {
+		
+		static constexpr std::array<Base<Conversions::Pressure>, 2U> s_Items {{
+			{ "Pa",  Conversions::Pressure::Pascal, 1 },
+			{ "bar", Conversions::Pressure::Bar,    1 },
+		}};
+	};
+	
+	template<> struct Prefixes::Bases<Conversions::Mass> {
+		
+		static constexpr std::array<Base<Conversions::Mass>, 2U> s_Items {{
+			{ "g", Conversions::Mass::Gram, 1 },
+			{ "t", Conversions::Mass::Ton,  1, 3 }, // SI admits only multiples of the tonne, and ft, pt, at and ct are other units.
+		}};
+	};
+	
+	template<> struct Prefixes::Bases<Conversions::Area> {
+		
+		static constexpr std::array<Base<Conversions::Area>, 3U> s_Items {{
+			{ "m²",  Conversions::Area::SquareMetre, 2 },
+			{ "m^2", Conversions::Area::SquareMetre, 2 },
+			{ "m2",  Conversions::Area::SquareMetre, 2 },
+		}};
+	};
+	
+	template<> struct Prefixes::Bases<Conversions::Volume> {
+		
+		static constexpr std::array<Base<Conversions::Volume>, 5U> s_Items {{
+			{ "m³",  Conversions::Volume::CubicMetre, 3 },
+			{ "m^3", Conversions::Volume::CubicMetre, 3 },
+			{ "m3",  Conversions::Volume::CubicMetre, 3 },
+			{ "L",   Conversions::Volume::Litre,      1 },
+			{ "l",   Conversions::Volume::Litre,      1 },
+		}};
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_PREFIXES_HPP
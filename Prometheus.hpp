@@ -0,0 +1,282 @@
+#ifndef LOUIERIKSSON_PROMETHEUS_HPP
+#define LOUIERIKSSON_PROMETHEUS_HPP
+
+#if !defined(LOUIERIKSSON_MATHS_INSTRUMENTATION)
+	#error "Define LOUIERIKSSON_MATHS_INSTRUMENTATION to export metrics."
+#endif
+
+#include "Conversions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @struct Prometheus
+	 * @brief Renders the counts and latencies recorded by Instrumentation in the Prometheus text exposition format.
+	 *
+	 * @details The following metric families are rendered, labelled by dimension (lower case, or "unknown" for
+	 * ParseColumn, which is given only a Plan) or operation:
+	 *
+	 * - unit_conversions_lookups_total{dimension,result}: Counter of TryGuessUnit calls, as hits and misses.
+	 * - unit_conversions_plans_total{dimension}: Counter of Plan::Make calls at runtime. The library resolves plans
+	 *   on demand rather than caching them, so this is the number of resolutions a plan cache would serve.
+	 * - unit_conversions_batch_size{dimension}: Histogram of the values per batch conversion call, in buckets of
+	 *   powers of four. Its count is the number of batch calls.
+	 * - unit_conversions_latency_seconds{operation}: Summary of the sampled latencies of lookups, plans and batches,
+	 *   at the 0.5, 0.9, 0.99 and 0.999 quantiles.
+	 * - unit_conversions_latency_sample_period: Gauge of the sampling period of the latencies.
+	 *
+	 * Render writes into a buffer of the caller's and does not allocate, so it may be called from a scrape handler
+	 * on any thread. WriteTextfile writes a file for the textfile collector of the node exporter.
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * char buffer[16384];
+	 *
+	 * const auto size = Prometheus::Render(buffer, sizeof(buffer));
+	 *
+	 * if (size <= sizeof(buffer)) {
+	 *     respond(std::string_view(buffer, size));
+	 * }
+	 * @endcode
+	 */
+	struct Prometheus final {
+		
+		/**
+		 * @brief Renders every metric family into a buffer.
+		 *
+		 * @param[out] _buffer Destination for the text. It is not null-terminated.
+		 * @param[in] _capacity The number of characters _buffer can hold.
+		 * @return The length of the text. If this exceeds _capacity, only the first _capacity characters were
+		 * written, and the call should be repeated with a larger buffer.
+		 */
+		static size_t Render(char* _buffer, const size_t& _capacity) {
+			
+			Writer out(_buffer, _capacity);
+			
+			out << "# HELP unit_conversions_lookups_total Symbol lookups (TryGuessUnit), by dimension and result.\n"
+			       "# TYPE unit_conversions_lookups_total counter\n";
+			
+			ForEachDimension([&out](const std::string_view& _dimension, const Instrumentation::Totals& _totals) {
+				
+				if (!_dimension.empty()) {
+					out << "unit_conversions_lookups_total{dimension=\"" << _dimension << "\",result=\"hit\"} "  << _totals.m_Hits   << '\n';
+					out << "unit_conversions_lookups_total{dimension=\"" << _dimension << "\",result=\"miss\"} " << _totals.m_Misses << '\n';
+				}
+			});
+			
+			out << "# HELP unit_conversions_plans_total Plans resolved at runtime (Plan::Make), by dimension.\n"
+			       "# TYPE unit_conversions_plans_total counter\n";
+			
+			ForEachDimension([&out](const std::string_view& _dimension, const Instrumentation::Totals& _totals) {
+				
+				if (!_dimension.empty()) {
+					out << "unit_conversions_plans_total{dimension=\"" << _dimension << "\"} " << _totals.m_Plans << '\n';
+				}
+			});
+			
+			out << "# HELP unit_conversions_batch_size Values per batch conversion call, by dimension.\n"
+			       "# TYPE unit_conversions_batch_size histogram\n";
+			
+			ForEachDimension([&out](const std::string_view& _dimension, const Instrumentation::Totals& _totals) {
+				
+				const auto dimension = _dimension.empty() ? std::string_view("unknown") : _dimension;
+				
+				uint64_t cumulative = 0U;
+				uint64_t bound      = 1U;
+				
+				for (size_t i = 0U; i < Instrumentation::s_BatchBuckets; ++i, bound *= 4U) {
+					
+					cumulative += _totals.m_BatchSizes[i];
+					
+					out << "unit_conversions_batch_size_bucket{dimension=\"" << dimension << "\",le=\"";
+					
+					if (i + 1U < Instrumentation::s_BatchBuckets) {
+						out << bound;
+					}
+					else {
+						out << "+Inf";
+					}
+					
+					out << "\"} " << cumulative << '\n';
+				}
+				
+				out << "unit_conversions_batch_size_sum{dimension=\""   << dimension << "\"} " << _totals.m_BatchValues << '\n';
+				out << "unit_conversions_batch_size_count{dimension=\"" << dimension << "\"} " << _totals.m_Batches     << '\n';
+			});
+			
+			out << "# HELP unit_conversions_latency_seconds Sampled latencies, by operation.\n"
+			       "# TYPE unit_conversions_latency_seconds summary\n";
+			
+			static constexpr std::string_view s_Operations[Instrumentation::s_Operations] { "lookup", "plan", "batch" };
+			static constexpr std::pair<std::string_view, double> s_Quantiles[] {
+				{ "0.5",   0.5   },
+				{ "0.9",   0.9   },
+				{ "0.99",  0.99  },
+				{ "0.999", 0.999 },
+			};
+			
+			for (size_t operation = 0U; operation < Instrumentation::s_Operations; ++operation) {
+				
+				// A snapshot is over 30 KB, so only one is held at a time.
+				const auto latency = Instrumentation::Latency(static_cast<Instrumentation::Operation>(operation));
+				
+				for (const auto& [label, quantile] : s_Quantiles) {
+					out << "unit_conversions_latency_seconds{operation=\"" << s_Operations[operation] << "\",quantile=\"" << label << "\"} ";
+					out.Nanoseconds(latency.Quantile(quantile));
+					out << '\n';
+				}
+				
+				out << "unit_conversions_latency_seconds_sum{operation=\"" << s_Operations[operation] << "\"} ";
+				out.Nanoseconds(latency.Mean() * static_cast<double>(latency.Count()));
+				out << '\n';
+				
+				out << "unit_conversions_latency_seconds_count{operation=\"" << s_Operations[operation] << "\"} " << latency.Count() << '\n';
+			}
+			
+			out << "# HELP unit_conversions_latency_sample_period One call in this many is timed on each thread.\n"
+			       "# TYPE unit_conversions_latency_sample_period gauge\n"
+			       "unit_conversions_latency_sample_period " << static_cast<uint64_t>(Instrumentation::SamplePeriod()) << '\n';
+			
+			return out.Size();
+		}
+		
+		/**
+		 * @brief Writes every metric family to a file, for the textfile collector of the node exporter.
+		 *
+		 * @details The text is written to a temporary file which then replaces _path, so the collector never reads
+		 * a partial file. _path should be in the collector's directory and end in ".prom".
+		 *
+		 * @param[in] _path Path to write the metrics to.
+		 *
+		 * @throws std::runtime_error If the file cannot be written.
+		 */
+		static void WriteTextfile(const std::string& _path) {
+			
+			std::vector<char> buffer(16384U);
+			
+			auto size = Render(buffer.data(), buffer.size());
+			
+			// The counts may grow between calls, and with them the text.
+			while (size > buffer.size()) {
+				buffer.resize(size + 1024U);
+				size = Render(buffer.data(), buffer.size());
+			}
+			
+			const auto temporary = _path + ".tmp";
+			
+			{
+				std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+				file.write(buffer.data(), static_cast<std::streamsize>(size));
+				
+				if (!file) {
+					throw std::runtime_error("Could not write \"" + temporary + "\".");
+				}
+			}
+			
+			if (std::rename(temporary.c_str(), _path.c_str()) != 0) {
+				std::remove(temporary.c_str());
+				throw std::runtime_error("Could not replace \"" + _path + "\".");
+			}
+		}
+	
+	private:
+		
+		/** @brief Appends text to a fixed buffer, counting (but discarding) whatever does not fit. */
+		class Writer final {
+		
+		public:
+			
+			Writer(char* _buffer, const size_t& _capacity) noexcept :
+				m_Buffer(_buffer),
+				m_Capacity(_capacity),
+				m_Size(0U) {}
+			
+			Writer& operator<<(const std::string_view& _text) noexcept {
+				
+				if (m_Size < m_Capacity) {
+					std::memcpy(m_Buffer + m_Size, _text.data(), std::min(_text.size(), m_Capacity - m_Size));
+				}
+				
+				m_Size += _text.size();
+				
+				return *this;
+			}
+			
+			Writer& operator<<(const char& _c) noexcept { return *this << std::string_view(&_c, 1U); }
+			
+			Writer& operator<<(uint64_t _value) noexcept {
+				
+				char digits[20];
+				auto* p = digits + sizeof(digits);
+				
+				do {
+					*--p = static_cast<char>('0' + (_value % 10U));
+					_value /= 10U;
+				}
+				while (_value != 0U);
+				
+				return *this << std::string_view(p, static_cast<size_t>((digits + sizeof(digits)) - p));
+			}
+			
+			/** @brief Appends a duration in seconds, given in nanoseconds, to the picosecond and without the locale. */
+			void Nanoseconds(const double& _nanoseconds) noexcept {
+				
+				const auto picoseconds = static_cast<uint64_t>(std::llround(std::min(std::max(_nanoseconds, 0.0), 9e15) * 1000.0));
+				
+				*this << (picoseconds / 1000U) << '.';
+				
+				const auto fraction = picoseconds % 1000U;
+				
+				const char digits[3] {
+					static_cast<char>('0' + (fraction / 100U)),
+					static_cast<char>('0' + ((fraction / 10U) % 10U)),
+					static_cast<char>('0' + (fraction % 10U)),
+				};
+				
+				*this << std::string_view(digits, sizeof(digits)) << "e-9";
+			}
+			
+			[[nodiscard]] size_t Size() const noexcept { return m_Size; }
+		
+		private:
+			
+			char* m_Buffer;
+			
+			size_t m_Capacity;
+			size_t m_Size;
+		};
+		
+		/** @brief Invokes _function with the name and totals of each dimension, then of batches of unknown dimension. */
+		template<typename TFunction>
+		static void ForEachDimension(const TFunction& _function) {
+			
+			_function(Conversions::Name<Conversions::Speed, true>(),       Instrumentation::Counters<Conversions::Speed>      ::Read());
+			_function(Conversions::Name<Conversions::Distance, true>(),    Instrumentation::Counters<Conversions::Distance>   ::Read());
+			_function(Conversions::Name<Conversions::Rotation, true>(),    Instrumentation::Counters<Conversions::Rotation>   ::Read());
+			_function(Conversions::Name<Conversions::Time, true>(),        Instrumentation::Counters<Conversions::Time>       ::Read());
+			_function(Conversions::Name<Conversions::Temperature, true>(), Instrumentation::Counters<Conversions::Temperature>::Read());
+			_function(Conversions::Name<Conversions::Pressure, true>(),    Instrumentation::Counters<Conversions::Pressure>   ::Read());
+			_function(Conversions::Name<Conversions::Mass, true>(),        Instrumentation::Counters<Conversions::Mass>       ::Read());
+			_function(Conversions::Name<Conversions::Area, true>(),        Instrumentation::Counters<Conversions::Area>       ::Read());
+			_function(Conversions::Name<Conversions::Volume, true>(),      Instrumentation::Counters<Conversions::Volume>     ::Read());
+			_function("",            Instrumentation::Counters<void>                    ::Read());
+		}
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_PROMETHEUS_HPP
@@ -0,0 +1,333 @@
+#ifndef LOUIERIKSSON_QUANTILE_SKETCH_HPP
+#define LOUIERIKSSON_QUANTILE_SKETCH_HPP
+
+#include "Conversions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @class QuantileSketch
+	 * @brief A mergeable streaming quantile sketch (a merging t-digest) over values stored in any unit of a dimension.
+	 *
+	 * @details Values are sketched in the unit they arrive in, with one digest per unit, so nothing is converted
+	 * when a value is added. Only when the sketch is queried are the centroids of each digest (of which there are
+	 * at most a few hundred, however many values were added) mapped into a common unit and merged. Every conversion
+	 * is monotonic and affine, so mapping a centroid maps its mean exactly and leaves its weight unchanged.
+	 *
+	 * Sketches merge digest-by-digest, so sketches built on separate threads or shards combine without
+	 * conversion, in any order.
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * QuantileSketch<Conversions::Pressure> sketch;
+	 *
+	 * sketch.Add(1013.25, Conversions::Pressure::Hectopascal);
+	 * sketch.Add(  14.70, Conversions::Pressure::PoundSquareInch);
+	 *
+	 * sketch.Merge(other_shard);
+	 *
+	 * const auto p99 = sketch.Quantile(0.99, Conversions::Pressure::Kilopascal);
+	 * @endcode
+	 */
+	template<typename TDimension>
+	class QuantileSketch final {
+	
+	public:
+		
+		using dimension_t = TDimension;
+		using unit_t      = typename TDimension::Unit;
+		
+		/**
+		 * @brief Creates an empty sketch.
+		 *
+		 * @param[in] _compression Bounds the number of centroids in each digest to roughly this value. Higher values
+		 * are more accurate, particularly near the median, at the cost of memory and query time.
+		 */
+		explicit QuantileSketch(const double& _compression = 200.0) :
+			m_Compression(_compression)
+		{
+			if (!(_compression >= 10.0)) {
+				throw std::invalid_argument("Compression must be at least 10.");
+			}
+		}
+		
+		/**
+		 * @brief Adds a value to the sketch.
+		 *
+		 * @param[in] _value The value. NaN values are ignored.
+		 * @param[in] _unit The unit of the value.
+		 */
+		void Add(const double& _value, const unit_t& _unit) {
+			
+			if (_value == _value) {
+				m_Digests[_unit].Add(_value, m_Compression);
+			}
+		}
+		
+		/**
+		 * @brief Adds an array of values stored in a single unit to the sketch.
+		 *
+		 * @param[in] _data Pointer to the first value.
+		 * @param[in] _size The number of values.
+		 * @param[in] _unit The unit the values are stored in.
+		 */
+		void Add(const double* _data, const size_t& _size, const unit_t& _unit) {
+			
+			auto& digest = m_Digests[_unit];
+			
+			for (size_t i = 0U; i < _size; ++i) {
+				
+				if (_data[i] == _data[i]) {
+					digest.Add(_data[i], m_Compression);
+				}
+			}
+		}
+		
+		/**
+		 * @brief Merges another sketch into this one.
+		 *
+		 * @param[in] _other The sketch to merge. Its compression need not match.
+		 */
+		void Merge(const QuantileSketch& _other) {
+			
+			for (size_t i = 0U; i < TDimension::s_Count; ++i) {
+				m_Digests[i].Merge(_other.m_Digests[i], m_Compression);
+			}
+		}
+		
+		/** @brief Returns the number of values added to the sketch. */
+		[[nodiscard]] double Count() const noexcept {
+			
+			double result = 0.0;
+			
+			for (const auto& digest : m_Digests) {
+				result += digest.Count();
+			}
+			
+			return result;
+		}
+		
+		/**
+		 * @brief Estimates a quantile of the values added to the sketch.
+		 *
+		 * @param[in] _q The quantile, in [0, 1].
+		 * @param[in] _unit The unit to return the estimate in.
+		 * @return The estimate, or NaN if the sketch is empty.
+		 */
+		[[nodiscard]] double Quantile(const double& _q, const unit_t& _unit) const {
+			
+			if (!(_q >= 0.0 && _q <= 1.0)) {
+				throw std::domain_error("Quantile must be within [0, 1].");
+			}
+			
+			Digest merged;
+			
+			for (size_t i = 0U; i < TDimension::s_Count; ++i) {
+				merged.Merge(m_Digests[i], Conversions::Plan::Make<TDimension>(static_cast<unit_t>(i), _unit), m_Compression);
+			}
+			
+			return merged.Quantile(_q, m_Compression);
+		}
+		
+		/** @brief Removes every value from the sketch. */
+		void Clear() noexcept {
+			
+			for (auto& digest : m_Digests) {
+				digest = Digest();
+			}
+		}
+	
+	private:
+		
+		struct Centroid final {
+			
+			double m_Mean;
+			double m_Weight;
+		};
+		
+		/** @brief A merging t-digest, using the arcsine scale function. */
+		class Digest final {
+		
+		public:
+			
+			[[nodiscard]] double Count() const noexcept {
+				return m_Weight + static_cast<double>(m_Buffer.size());
+			}
+			
+			void Add(const double& _value, const double& _compression) {
+				
+				m_Buffer.emplace_back(_value);
+				
+				if (m_Buffer.size() >= BufferLimit(_compression)) {
+					Compress(_compression);
+				}
+			}
+			
+			void Merge(const Digest& _other, const double& _compression) {
+				Merge(_other, Conversions::Plan{}, _compression);
+			}
+			
+			/* Merges _other, mapping its centroids into the unit of this digest with _plan. */
+			void Merge(const Digest& _other, const Conversions::Plan& _plan, const double& _compression) {
+				
+				if (_other.Count() == 0.0) {
+					return;
+				}
+				
+				for (const auto& centroid : _other.m_Centroids) {
+					m_Incoming.push_back({ _plan(centroid.m_Mean), centroid.m_Weight });
+				}
+				
+				for (const auto& value : _other.m_Buffer) {
+					m_Buffer.emplace_back(_plan(value));
+				}
+				
+				m_Min = std::min(m_Min, _plan(_other.m_Min));
+				m_Max = std::max(m_Max, _plan(_other.m_Max));
+				
+				Compress(_compression);
+			}
+			
+			[[nodiscard]] double Quantile(const double& _q, const double& _compression) {
+				
+				Compress(_compression);
+				
+				if (m_Centroids.empty()) {
+					return std::numeric_limits<double>::quiet_NaN();
+				}
+				
+				if (m_Centroids.size() == 1U) {
+					return m_Centroids.front().m_Mean;
+				}
+				
+				const auto target = _q * m_Weight;
+				
+				// Between the minimum and the centre of the first centroid:
+				const auto& first = m_Centroids.front();
+				
+				if (target < first.m_Weight / 2.0) {
+					return m_Min + ((first.m_Mean - m_Min) * (target / (first.m_Weight / 2.0)));
+				}
+				
+				// Between the centres of adjacent centroids:
+				auto cumulative = first.m_Weight / 2.0;
+				
+				for (size_t i = 1U; i < m_Centroids.size(); ++i) {
+					
+					const auto& lhs = m_Centroids[i - 1U];
+					const auto& rhs = m_Centroids[i];
+					
+					const auto span = (lhs.m_Weight + rhs.m_Weight) / 2.0;
+					
+					if (target < cumulative + span) {
+						return lhs.m_Mean + ((rhs.m_Mean - lhs.m_Mean) * ((target - cumulative) / span));
+					}
+					
+					cumulative += span;
+				}
+				
+				// Between the centre of the last centroid and the maximum:
+				const auto& last = m_Centroids.back();
+				
+				return last.m_Mean + ((m_Max - last.m_Mean) * std::min(1.0, (target - cumulative) / (last.m_Weight / 2.0)));
+			}
+		
+		private:
+			
+			std::vector<Centroid> m_Centroids;
+			std::vector<Centroid> m_Incoming;
+			std::vector<double>   m_Buffer;
+			
+			double m_Weight = 0.0;
+			double m_Min    =  std::numeric_limits<double>::infinity();
+			double m_Max    = -std::numeric_limits<double>::infinity();
+			
+			[[nodiscard]] static size_t BufferLimit(const double& _compression) noexcept {
+				return static_cast<size_t>(_compression) * 5U;
+			}
+			
+			void Compress(const double& _compression) {
+				
+				if (m_Buffer.empty() && m_Incoming.empty()) {
+					return;
+				}
+				
+				for (const auto& value : m_Buffer) {
+					
+					m_Incoming.push_back({ value, 1.0 });
+					
+					m_Min = std::min(m_Min, value);
+					m_Max = std::max(m_Max, value);
+				}
+				
+				m_Buffer.clear();
+				
+				m_Incoming.insert(m_Incoming.end(), m_Centroids.begin(), m_Centroids.end());
+				m_Centroids.clear();
+				
+				std::sort(m_Incoming.begin(), m_Incoming.end(), [](const Centroid& _lhs, const Centroid& _rhs) {
+					return _lhs.m_Mean < _rhs.m_Mean;
+				});
+				
+				m_Weight = 0.0;
+				
+				for (const auto& centroid : m_Incoming) {
+					m_Weight += centroid.m_Weight;
+				}
+				
+				// Merge neighbouring centroids while they stay within the size permitted by the scale function.
+				auto before = 0.0;
+				auto limit  = m_Weight * Q(K(0.0, _compression) + 1.0, _compression);
+				
+				m_Centroids.push_back(m_Incoming.front());
+				
+				for (size_t i = 1U; i < m_Incoming.size(); ++i) {
+					
+					auto&       current = m_Centroids.back();
+					const auto& next    = m_Incoming[i];
+					
+					if (before + current.m_Weight + next.m_Weight <= limit) {
+						
+						current.m_Weight += next.m_Weight;
+						current.m_Mean   += (next.m_Mean - current.m_Mean) * (next.m_Weight / current.m_Weight);
+					}
+					else {
+						
+						before += current.m_Weight;
+						limit   = m_Weight * Q(K(before / m_Weight, _compression) + 1.0, _compression);
+						
+						m_Centroids.push_back(next);
+					}
+				}
+				
+				m_Incoming.clear();
+			}
+			
+			[[nodiscard]] static double K(const double& _q, const double& _compression) noexcept {
+				return (_compression / (2.0 * s_Pi)) * std::asin((2.0 * _q) - 1.0);
+			}
+			
+			[[nodiscard]] static double Q(const double& _k, const double& _compression) noexcept {
+				return _k >= _compression / 4.0 ? 1.0 : (std::sin((2.0 * s_Pi * _k) / _compression) + 1.0) / 2.0;
+			}
+			
+			static constexpr double s_Pi = 3.14159265358979323846;
+		};
+		
+		double m_Compression;
+		
+		std::array<Digest, TDimension::s_Count> m_Digests;
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_QUANTILE_SKETCH_HPP
@@ -0,0 +1,181 @@
+#ifndef LOUIERIKSSON_QUANTITY_HPP
+#define LOUIERIKSSON_QUANTITY_HPP
+
+#include "Conversions.hpp"
+
+#include <type_traits>
+
+namespace LouiEriksson::Maths::Quantities {
+	
+	/**
+	 * @struct Dimension
+	 * @brief The exponents of the base dimensions (length, time, mass and temperature) of a physical quantity.
+	 */
+	template<int L, int T, int M, int K>
+	struct Dimension final {
+		
+		static constexpr int s_Length      = L;
+		static constexpr int s_Time        = T;
+		static constexpr int s_Mass        = M;
+		static constexpr int s_Temperature = K;
+	};
+	
+	template<typename TLeft, typename TRight>
+	using dimension_product_t = Dimension<
+		TLeft::s_Length      + TRight::s_Length,
+		TLeft::s_Time        + TRight::s_Time,
+		TLeft::s_Mass        + TRight::s_Mass,
+		TLeft::s_Temperature + TRight::s_Temperature
+	>;
+	
+	template<typename TLeft, typename TRight>
+	using dimension_quotient_t = Dimension<
+		TLeft::s_Length      - TRight::s_Length,
+		TLeft::s_Time        - TRight::s_Time,
+		TLeft::s_Mass        - TRight::s_Mass,
+		TLeft::s_Temperature - TRight::s_Temperature
+	>;
+	
+	using Dimensionless = Dimension<0, 0, 0, 0>;
+	
+	/**
+	 * @struct Units
+	 * @brief Associates a Dimension with the Conversions table which holds its units.
+	 *
+	 * @details Specialisations provide the table and the SI unit which quantities of the dimension are stored in.
+	 * Dimensions without a specialisation (such as density) can still be computed with, but only in SI units.
+	 */
+	template<typename TDimension>
+	struct Units;
+	
+	template<> struct Units<Dimension< 1,  0, 0, 0>> { using conversions_t = Conversions::Distance;    static constexpr auto s_Base = Conversions::Distance::Metre;         };
+	template<> struct Units<Dimension< 0,  1, 0, 0>> { using conversions_t = Conversions::Time;        static constexpr auto s_Base = Conversions::Time::Second;            };
+	template<> struct Units<Dimension< 0,  0, 1, 0>> { using conversions_t = Conversions::Mass;        static constexpr auto s_Base = Conversions::Mass::Kilogram;          };
+	template<> struct Units<Dimension< 0,  0, 0, 1>> { using conversions_t = Conversions::Temperature; static constexpr auto s_Base = Conversions::Temperature::Kelvin;     };
+	template<> struct Units<Dimension< 1, -1, 0, 0>> { using conversions_t = Conversions::Speed;       static constexpr auto s_Base = Conversions::Speed::MetreSecond;      };
+	template<> struct Units<Dimension< 2,  0, 0, 0>> { using conversions_t = Conversions::Area;        static constexpr auto s_Base = Conversions::Area::SquareMetre;       };
+	template<> struct Units<Dimension< 3,  0, 0, 0>> { using conversions_t = Conversions::Volume;      static constexpr auto s_Base = Conversions::Volume::CubicMetre;      };
+	template<> struct Units<Dimension<-1, -2, 1, 0>> { using conversions_t = Conversions::Pressure;    static constexpr auto s_Base = Conversions::Pressure::Pascal;        };
+	
+	/**
+	 * @class Quantity
+	 * @brief A value tagged at compile time with the Dimension it measures.
+	 *
+	 * @details The value is held in SI units, so arithmetic is plain arithmetic on the value and dimensional
+	 * consistency is checked entirely by the type system. Conversions from and to the units of the Conversions
+	 * tables are constant multiplies, and fold away when the unit is known at compile time.
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * constexpr Quantities::Distance d(100.0, Conversions::Distance::Kilometre);
+	 * constexpr Quantities::Time     t(  1.0, Conversions::Time::Hour);
+	 *
+	 * constexpr Quantities::Speed s = d / t;
+	 *
+	 * static_assert(s.In(Conversions::Speed::MetreSecond) > 27.0);
+	 * @endcode
+	 */
+	template<typename TDimension, typename T = double>
+	class Quantity final {
+		
+		static_assert(std::is_floating_point_v<T>, "Quantity values must be of a floating-point type.");
+	
+	public:
+		
+		using dimension_t = TDimension;
+		using value_t     = T;
+		
+		constexpr Quantity() noexcept :
+			m_Value(0.0) {}
+		
+		/**
+		 * @brief Creates a quantity from a value in SI units.
+		 *
+		 * @param[in] _value The value in SI units.
+		 */
+		explicit constexpr Quantity(const T& _value) noexcept :
+			m_Value(_value) {}
+		
+		/**
+		 * @brief Creates a quantity from a value in a unit of the dimension.
+		 *
+		 * @param[in] _value The value to be converted.
+		 * @param[in] _unit The unit of the value.
+		 */
+		template<typename TUnit>
+		constexpr Quantity(const T& _value, const TUnit& _unit) :
+			m_Value(Conversions::Plan::Make<typename Units<TDimension>::conversions_t>(_unit, Units<TDimension>::s_Base)(_value))
+		{
+			static_assert(std::is_same_v<TUnit, typename Units<TDimension>::conversions_t::Unit>, "The unit does not measure this dimension.");
+		}
+		
+		/** @brief Returns the value in SI units. */
+		[[nodiscard]] constexpr const T& Value() const noexcept { return m_Value; }
+		
+		/**
+		 * @brief Returns the value in a unit of the dimension.
+		 *
+		 * @param[in] _unit The unit to convert to.
+		 * @return The converted value.
+		 */
+		template<typename TUnit>
+		[[nodiscard]] constexpr T In(const TUnit& _unit) const {
+			
+			static_assert(std::is_same_v<TUnit, typename Units<TDimension>::conversions_t::Unit>, "The unit does not measure this dimension.");
+			
+			return Conversions::Plan::Make<typename Units<TDimension>::conversions_t>(Units<TDimension>::s_Base, _unit)(m_Value);
+		}
+		
+		/** @brief Dimensionless quantities decay to their value. */
+		template<typename D = TDimension, std::enable_if_t<std::is_same_v<D, Dimensionless>, bool> = true>
+		constexpr operator T() const noexcept { return m_Value; }
+		
+		constexpr Quantity& operator+=(const Quantity& _other) noexcept { m_Value += _other.m_Value; return *this; }
+		constexpr Quantity& operator-=(const Quantity& _other) noexcept { m_Value -= _other.m_Value; return *this; }
+		constexpr Quantity& operator*=(const T& _scalar)       noexcept { m_Value *= _scalar;        return *this; }
+		constexpr Quantity& operator/=(const T& _scalar)       noexcept { m_Value /= _scalar;        return *this; }
+		
+		[[nodiscard]] constexpr Quantity operator-() const noexcept { return Quantity(-m_Value); }
+		
+		[[nodiscard]] friend constexpr Quantity operator+(const Quantity& _lhs, const Quantity& _rhs) noexcept { return Quantity(_lhs.m_Value + _rhs.m_Value); }
+		[[nodiscard]] friend constexpr Quantity operator-(const Quantity& _lhs, const Quantity& _rhs) noexcept { return Quantity(_lhs.m_Value - _rhs.m_Value); }
+		[[nodiscard]] friend constexpr Quantity operator*(const Quantity& _lhs, const T& _rhs)        noexcept { return Quantity(_lhs.m_Value * _rhs);          }
+		[[nodiscard]] friend constexpr Quantity operator*(const T& _lhs, const Quantity& _rhs)        noexcept { return Quantity(_lhs * _rhs.m_Value);          }
+		[[nodiscard]] friend constexpr Quantity operator/(const Quantity& _lhs, const T& _rhs)        noexcept { return Quantity(_lhs.m_Value / _rhs);          }
+		
+		[[nodiscard]] friend constexpr bool operator==(const Quantity& _lhs, const Quantity& _rhs) noexcept { return _lhs.m_Value == _rhs.m_Value; }
+		[[nodiscard]] friend constexpr bool operator!=(const Quantity& _lhs, const Quantity& _rhs) noexcept { return _lhs.m_Value != _rhs.m_Value; }
+		[[nodiscard]] friend constexpr bool operator< (const Quantity& _lhs, const Quantity& _rhs) noexcept { return _lhs.m_Value <  _rhs.m_Value; }
+		[[nodiscard]] friend constexpr bool operator<=(const Quantity& _lhs, const Quantity& _rhs) noexcept { return _lhs.m_Value <= _rhs.m_Value; }
+		[[nodiscard]] friend constexpr bool operator> (const Quantity& _lhs, const Quantity& _rhs) noexcept { return _lhs.m_Value >  _rhs.m_Value; }
+		[[nodiscard]] friend constexpr bool operator>=(const Quantity& _lhs, const Quantity& _rhs) noexcept { return _lhs.m_Value >= _rhs.m_Value; }
+	
+	private:
+		
+		T m_Value;
+	};
+	
+	template<typename TLeft, typename TRight, typename T>
+	[[nodiscard]] constexpr Quantity<dimension_product_t<TLeft, TRight>, T> operator*(const Quantity<TLeft, T>& _lhs, const Quantity<TRight, T>& _rhs) noexcept {
+		return Quantity<dimension_product_t<TLeft, TRight>, T>(_lhs.Value() * _rhs.Value());
+	}
+	
+	template<typename TLeft, typename TRight, typename T>
+	[[nodiscard]] constexpr Quantity<dimension_quotient_t<TLeft, TRight>, T> operator/(const Quantity<TLeft, T>& _lhs, const Quantity<TRight, T>& _rhs) noexcept {
+		return Quantity<dimension_quotient_t<TLeft, TRight>, T>(_lhs.Value() / _rhs.Value());
+	}
+	
+	using Distance    = Quantity<Dimension< 1,  0, 0, 0>>;
+	using Time        = Quantity<Dimension< 0,  1, 0, 0>>;
+	using Mass        = Quantity<Dimension< 0,  0, 1, 0>>;
+	using Temperature = Quantity<Dimension< 0,  0, 0, 1>>;
+	using Speed       = Quantity<Dimension< 1, -1, 0, 0>>;
+	using Area        = Quantity<Dimension< 2,  0, 0, 0>>;
+	using Volume      = Quantity<Dimension< 3,  0, 0, 0>>;
+	using Density     = Quantity<Dimension<-3,  0, 1, 0>>;
+	using Pressure    = Quantity<Dimension<-1, -2, 1, 0>>;
+	
+} // LouiEriksson::Maths::Quantities
+
+#endif //LOUIERIKSSON_QUANTITY_HPP
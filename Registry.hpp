@@ -0,0 +1,1279 @@
+#ifndef LOUIERIKSSON_REGISTRY_HPP
+#define LOUIERIKSSON_REGISTRY_HPP
+
+#include "Conversions.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @class Registry
+	 * @brief A runtime-extensible set of dimensions and units, compiled into dense tables.
+	 *
+	 * @details A Registry starts with every built-in dimension of Conversions, with the same Unit indices, and may be
+	 * extended with unit-definition files. After every change the definitions are compiled into flat tables: a
+	 * string pool, a perfect hash over (dimension, alias) pairs, and a dense matrix of Conversions::Plan per
+	 * dimension. Lookups therefore hash the symbol once, and conversions are a single table read.
+	 *
+	 * Unit-definition files are line-based. A `#` begins a comment, and `[Name]` opens a dimension, extending it if
+	 * it already exists. Every other line defines a unit:
+	 *
+	 * @code
+	 * [Pressure]
+	 * kgf/mm2, kgf/mm² = 100 kg/cm2
+	 * inH2O_60F        = 248.84 Pa
+	 *
+	 * [Temperature]
+	 * °Ra, Ra, rankine = 0.5555555555555556 K
+	 * @endcode
+	 *
+	 * The left-hand side lists the symbol of the unit followed by any aliases. The right-hand side gives the factor,
+	 * an optional reference unit (otherwise the base unit of the dimension), and an optional offset introduced by
+	 * `+` or `-`, such that `reference = (factor * unit) + offset`. References may chain through units defined
+	 * anywhere in the same dimension; they are flattened to direct factors when compiled.
+	 *
+	 * The compiled tables can be saved as a binary snapshot, which Map loads without parsing or compiling anything.
+	 */
+	class Registry final {
+	
+	public:
+		
+		using conversion_scalar_t = Conversions::conversion_scalar_t;
+		
+		/**
+		 * @struct Unit
+		 * @brief Identifies a unit of a dimension in the Registry.
+		 *
+		 * @note For the built-in dimensions, m_Index is equal to the value of the corresponding Unit enum.
+		 */
+		struct Unit final {
+			
+			uint16_t m_Dimension;
+			uint16_t m_Index;
+			
+			[[nodiscard]] constexpr bool operator==(const Unit& _other) const noexcept { return m_Dimension == _other.m_Dimension && m_Index == _other.m_Index; }
+			[[nodiscard]] constexpr bool operator!=(const Unit& _other) const noexcept { return !(*this == _other); }
+		};
+		
+		/** @brief Creates a Registry holding the built-in dimensions. */
+		Registry() {
+			
+			Seed<Conversions::Speed>      (Conversions::Speed::MetreSecond   );
+			Seed<Conversions::Distance>   (Conversions::Distance::Metre      );
+			Seed<Conversions::Rotation>   (Conversions::Rotation::Degree     );
+			Seed<Conversions::Time>       (Conversions::Time::Second         );
+			Seed<Conversions::Temperature>(Conversions::Temperature::Kelvin  );
+			Seed<Conversions::Pressure>   (Conversions::Pressure::Atmosphere );
+			Seed<Conversions::Mass>       (Conversions::Mass::Kilogram       );
+			Seed<Conversions::Area>       (Conversions::Area::SquareMetre    );
+			Seed<Conversions::Volume>     (Conversions::Volume::CubicMetre   );
+			
+			Compile(m_Staged);
+		}
+		
+		/**
+		 * @brief Loads a unit-definition file and recompiles the tables.
+		 *
+		 * @param[in] _path Path to the unit-definition file.
+		 *
+		 * @throws std::runtime_error If the file cannot be read, or contains an invalid definition.
+		 * @throws std::length_error If the definitions exceed the dimensions or units a Registry can hold.
+		 */
+		void Load(const std::string& _path) {
+
+#if defined(__unix__) || defined(__APPLE__)
+			
+			const int fd = ::open(_path.c_str(), O_RDONLY);
+			
+			if (fd == -1) {
+				throw std::runtime_error("Could not open \"" + _path + "\".");
+			}
+			
+			struct stat info{};
+			
+			if (::fstat(fd, &info) == -1) {
+				::close(fd);
+				throw std::runtime_error("Could not stat \"" + _path + "\".");
+			}
+			
+			const auto size = static_cast<size_t>(info.st_size);
+			
+			if (size == 0U) {
+				::close(fd);
+				return;
+			}
+			
+			void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			::close(fd);
+			
+			if (mapping == MAP_FAILED) {
+				throw std::runtime_error("Could not map \"" + _path + "\".");
+			}
+			
+			try {
+				Parse({ static_cast<const char*>(mapping), size }, _path);
+			}
+			catch (...) {
+				::munmap(mapping, size);
+				throw;
+			}
+			
+			::munmap(mapping, size);
+#else
+			std::ifstream file(_path, std::ios::binary);
+			
+			if (!file) {
+				throw std::runtime_error("Could not open \"" + _path + "\".");
+			}
+			
+			const std::string text { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+			
+			Parse(text, _path);
+#endif
+		}
+		
+		/**
+		 * @brief Parses unit definitions from memory and recompiles the tables.
+		 *
+		 * @param[in] _text The unit definitions.
+		 * @param[in] _source (Optional) Name of the source, used in error messages.
+		 *
+		 * @throws std::runtime_error If the text contains an invalid definition.
+		 * @throws std::length_error If the definitions exceed the dimensions or units a Registry can hold.
+		 *
+		 * @note On any error, the Registry is left unchanged.
+		 */
+		void Parse(const std::string_view& _text, const std::string& _source = "<memory>") {
+			
+			auto staged = m_Staged.empty() ? Thaw() : m_Staged;
+			
+			std::optional<size_t> section;
+			
+			size_t line_number = 0U;
+			
+			for (size_t begin = 0U; begin < _text.size();) {
+				
+				auto end = _text.find('\n', begin);
+				
+				if (end == std::string_view::npos) {
+					end = _text.size();
+				}
+				
+				++line_number;
+				
+				auto line = _text.substr(begin, end - begin);
+				begin = end + 1U;
+				
+				const auto fail = [&](const std::string& _message) {
+					throw std::runtime_error(_source + ":" + std::to_string(line_number) + ": " + _message);
+				};
+				
+				if (const auto comment = line.find('#'); comment != std::string_view::npos) {
+					line = line.substr(0U, comment);
+				}
+				
+				line = Trim(line);
+				
+				if (line.empty()) {
+					continue;
+				}
+				
+				if (line.front() == '[') {
+					
+					if (line.back() != ']') {
+						fail("Unterminated section name.");
+					}
+					
+					const auto name = Trim(line.substr(1U, line.size() - 2U));
+					
+					if (name.empty()) {
+						fail("Empty section name.");
+					}
+					
+					section = Find(staged, name);
+					
+					if (!section) {
+						section = staged.size();
+						staged.push_back({ std::string(name), {} });
+					}
+					
+					continue;
+				}
+				
+				if (!section) {
+					fail("Unit defined outside of a section.");
+				}
+				
+				const auto equals = line.find('=');
+				
+				if (equals == std::string_view::npos) {
+					fail("Expected '='.");
+				}
+				
+				StagedUnit unit{};
+				
+				// Symbol and aliases:
+				for (auto names = line.substr(0U, equals); !names.empty();) {
+					
+					const auto comma = std::min(names.find(','), names.size());
+					const auto name  = Trim(names.substr(0U, comma));
+					
+					if (name.empty()) {
+						fail("Empty unit name.");
+					}
+					
+					unit.m_Names.emplace_back(name);
+					
+					names = comma < names.size() ? names.substr(comma + 1U) : std::string_view{};
+				}
+				
+				if (unit.m_Names.empty()) {
+					fail("Expected a unit name.");
+				}
+				
+				// Factor, reference and offset:
+				std::vector<std::string_view> tokens;
+				
+				for (auto rest = Trim(line.substr(equals + 1U)); !rest.empty(); rest = Trim(rest)) {
+					
+					const auto space = std::min(rest.find_first_of(" \t"), rest.size());
+					
+					tokens.push_back(rest.substr(0U, space));
+					rest.remove_prefix(space);
+				}
+				
+				if (tokens.empty() || !ParseNumber(tokens.front(), unit.m_Scale)) {
+					fail("Expected a factor.");
+				}
+				
+				// The factor is divided out of every plan to the unit, so must be finite and nonzero.
+				if (!(std::isfinite(unit.m_Scale) && unit.m_Scale > 0)) {
+					fail("Factor must be finite and greater than zero.");
+				}
+				
+				auto reference_end = tokens.size();
+				
+				if (tokens.size() >= 3U && (tokens[tokens.size() - 2U] == "+" || tokens[tokens.size() - 2U] == "-")) {
+					
+					if (!ParseNumber(tokens.back(), unit.m_Offset)) {
+						fail("Expected an offset.");
+					}
+					
+					if (!std::isfinite(unit.m_Offset)) {
+						fail("Offset must be finite.");
+					}
+					
+					if (tokens[tokens.size() - 2U] == "-") {
+						unit.m_Offset = -unit.m_Offset;
+					}
+					
+					reference_end -= 2U;
+				}
+				
+				for (size_t i = 1U; i < reference_end; ++i) {
+					
+					if (!unit.m_Reference.empty()) {
+						unit.m_Reference += ' ';
+					}
+					
+					unit.m_Reference += tokens[i];
+				}
+				
+				unit.m_Line = line_number;
+				
+				// Against the units defined before, and the names before it in the same definition.
+				for (auto name = unit.m_Names.begin(); name != unit.m_Names.end(); ++name) {
+					
+					if (FindUnit(staged[*section], *name) || std::find(unit.m_Names.begin(), name, *name) != name) {
+						fail("\"" + *name + "\" is already defined in " + staged[*section].m_Name + ".");
+					}
+				}
+				
+				staged[*section].m_Units.push_back(std::move(unit));
+			}
+			
+			for (auto& dimension : staged) {
+				Flatten(dimension, _source);
+			}
+			
+			// Compiled before being kept, so that a failure leaves both the definitions and the tables unchanged.
+			Compile(staged);
+			
+			m_Staged = std::move(staged);
+		}
+		
+		/**
+		 * @brief Get the index of a dimension by name.
+		 *
+		 * @param[in] _name The name of the dimension, as it appears in a section header.
+		 * @return The index of the dimension, if it exists.
+		 */
+		[[nodiscard]] std::optional<uint16_t> Dimension(const std::string_view& _name) const {
+			
+			for (size_t i = 0U; i < m_Dimensions.size(); ++i) {
+				
+				if (String(m_Dimensions[i].m_Name) == _name) {
+					return static_cast<uint16_t>(i);
+				}
+			}
+			
+			return std::nullopt;
+		}
+		
+		/** @brief Get the number of dimensions. */
+		[[nodiscard]] size_t DimensionCount() const noexcept { return m_Dimensions.size(); }
+		
+		/** @brief Get the number of units of a dimension. */
+		[[nodiscard]] size_t UnitCount(const uint16_t& _dimension) const { return m_Dimensions.at(_dimension).m_UnitCount; }
+		
+		/**
+		 * @brief Tries to guess the Unit of a dimension based on the provided symbol.
+		 *
+		 * @param[in] _dimension The index of the dimension.
+		 * @param[in] _symbol The symbol to try to guess the Unit from.
+		 * @return The Unit if a match is found, otherwise an empty optional.
+		 */
+		[[nodiscard]] std::optional<Unit> TryGuessUnit(const uint16_t& _dimension, const std::string_view& _symbol) const {
+			
+			if (!m_Slots.empty()) {
+				
+				const auto hash = Hash(_dimension, _symbol, m_Seed);
+				const auto slot = Slot(hash, m_Displacements[hash % m_Displacements.size()], m_Slots.size());
+				
+				if (const auto index = m_Slots[slot]; index != s_Empty) {
+					
+					const auto& alias = m_Aliases[index];
+					
+					if (alias.m_Dimension == _dimension && String(alias.m_Name) == _symbol) {
+						return Unit { alias.m_Dimension, alias.m_Unit };
+					}
+				}
+			}
+			
+			return std::nullopt;
+		}
+		
+		/**
+		 * @brief Get the Plan which converts between two units of the same dimension.
+		 *
+		 * @param[in] _from The unit to convert from.
+		 * @param[in] _to The unit to convert to.
+		 * @return The resolved Plan.
+		 *
+		 * @throws std::invalid_argument If the units are of different dimensions.
+		 * @throws std::out_of_range If either unit is not in the Registry, such as one from another Registry.
+		 */
+		[[nodiscard]] const Conversions::Plan& GetPlan(const Unit& _from, const Unit& _to) const {
+			
+			if (_from.m_Dimension != _to.m_Dimension) {
+				throw std::invalid_argument("Cannot convert between units of different dimensions.");
+			}
+			
+			const auto& dimension = m_Dimensions.at(_from.m_Dimension);
+			
+			if (_from.m_Index >= dimension.m_UnitCount || _to.m_Index >= dimension.m_UnitCount) {
+				throw std::out_of_range("Unit out of range.");
+			}
+			
+			return m_Plans[dimension.m_Plans + (static_cast<size_t>(_from.m_Index) * dimension.m_UnitCount) + _to.m_Index];
+		}
+		
+		/**
+		 * @brief Converts a value from one unit to another.
+		 *
+		 * @param[in] _val The value to be converted.
+		 * @param[in] _from The unit to convert from.
+		 * @param[in] _to The unit to convert to.
+		 *
+		 * @return The converted value.
+		 */
+		[[nodiscard]] conversion_scalar_t Convert(const conversion_scalar_t& _val, const Unit& _from, const Unit& _to) const {
+			return GetPlan(_from, _to)(_val);
+		}
+		
+		/**
+		 * @brief Get the symbol associated with a given Unit.
+		 *
+		 * @param[in] _unit The Unit.
+		 * @return A view of the symbol, valid for the lifetime of the Registry's tables.
+		 *
+		 * @throws std::out_of_range If the unit is not in the Registry, such as one from another Registry.
+		 */
+		[[nodiscard]] std::string_view Symbol(const Unit& _unit) const {
+			
+			const auto& dimension = m_Dimensions.at(_unit.m_Dimension);
+			
+			if (_unit.m_Index >= dimension.m_UnitCount) {
+				throw std::out_of_range("Unit out of range.");
+			}
+			
+			return String(m_Symbols[dimension.m_Units + _unit.m_Index]);
+		}
+		
+		/**
+		 * @brief Writes the compiled tables to a snapshot file, which Map can load without recompiling them.
+		 *
+		 * @details The snapshot is versioned and position-independent: every table is stored at an aligned offset from
+		 * the start of the file, and padding is written as zeros, so that the same tables always give the same bytes.
+		 * It is written to a uniquely named temporary file beside _path which then replaces it, so processes mapping
+		 * an older snapshot, or saving concurrently, are unaffected.
+		 *
+		 * @param[in] _path Path to write the snapshot to.
+		 *
+		 * @throws std::runtime_error If the snapshot cannot be written.
+		 */
+		void Save(const std::string& _path) const {
+			
+			std::string buffer(sizeof(SnapshotHeader), '\0');
+			
+			const auto write = [&buffer](const auto& _table) {
+				
+				using value_t = typename std::decay_t<decltype(_table)>::value_t;
+				
+				buffer.resize(Align(buffer.size()), '\0');
+				
+				const SnapshotSection result { buffer.size(), _table.size() };
+				
+				if constexpr (std::is_same_v<value_t, Conversions::Plan>) {
+					
+					// Field by field, as the padding of an extended-precision scalar is never initialised.
+					buffer.resize(buffer.size() + (_table.size() * sizeof(value_t)), '\0');
+					
+					auto* plan = buffer.data() + result.m_Offset;
+					
+					for (const auto& item : _table) {
+						std::memcpy(plan + offsetof(Conversions::Plan, m_Scale),  &item.m_Scale,  s_ScalarBytes);
+						std::memcpy(plan + offsetof(Conversions::Plan, m_Offset), &item.m_Offset, s_ScalarBytes);
+						
+						plan += sizeof(value_t);
+					}
+				}
+				else {
+					buffer.append(reinterpret_cast<const char*>(_table.begin()), _table.size() * sizeof(value_t));
+				}
+				
+				return result;
+			};
+			
+			SnapshotHeader header{};
+			std::memcpy(header.m_Magic, s_Magic, sizeof(s_Magic));
+			header.m_Version       = s_Version;
+			header.m_Endianness    = s_Endianness;
+			header.m_ScalarSize    = sizeof(conversion_scalar_t);
+			header.m_ScalarDigits  = std::numeric_limits<conversion_scalar_t>::digits;
+			header.m_Seed          = m_Seed;
+			header.m_Pool          = write(m_Pool);
+			header.m_Dimensions    = write(m_Dimensions);
+			header.m_Symbols       = write(m_Symbols);
+			header.m_Aliases       = write(m_Aliases);
+			header.m_Plans         = write(m_Plans);
+			header.m_Bases         = write(m_Bases);
+			header.m_Displacements = write(m_Displacements);
+			header.m_Slots         = write(m_Slots);
+			header.m_Size          = buffer.size();
+			
+			std::memcpy(buffer.data(), &header, sizeof(header));
+			
+#if defined(__unix__) || defined(__APPLE__)
+			
+			std::string temporary = _path + ".XXXXXX";
+			
+			const int fd = ::mkstemp(temporary.data());
+			
+			if (fd == -1) {
+				throw std::runtime_error("Could not create a temporary file for \"" + _path + "\".");
+			}
+			
+			bool written = ::fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) == 0;
+			
+			for (size_t offset = 0U; written && offset < buffer.size();) {
+				
+				const auto count = ::write(fd, buffer.data() + offset, buffer.size() - offset);
+				
+				if (count > 0) {
+					offset += static_cast<size_t>(count);
+				}
+				else if (count == -1 && errno == EINTR) {
+					continue;
+				}
+				else {
+					written = false;
+				}
+			}
+			
+			written = (::close(fd) == 0) && written;
+			
+			if (!written) {
+				std::remove(temporary.c_str());
+				throw std::runtime_error("Could not write \"" + temporary + "\".");
+			}
+#else
+			const auto temporary = _path + ".tmp";
+			
+			{
+				std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+				file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+				
+				if (!file) {
+					throw std::runtime_error("Could not write \"" + temporary + "\".");
+				}
+			}
+#endif
+			
+			if (std::rename(temporary.c_str(), _path.c_str()) != 0) {
+				std::remove(temporary.c_str());
+				throw std::runtime_error("Could not replace \"" + _path + "\".");
+			}
+		}
+		
+		/**
+		 * @brief Creates a Registry from a snapshot written by Save.
+		 *
+		 * @details Where supported, the snapshot is mapped read-only and shared, so that the tables are neither
+		 * rebuilt nor copied, and every process mapping the same snapshot shares its pages. The snapshot stays mapped
+		 * for as long as the Registry, or any copy of it, is alive. Loading further definitions into the Registry
+		 * copies its tables out of the snapshot first.
+		 *
+		 * @param[in] _path Path to the snapshot.
+		 * @return A Registry over the snapshot's tables.
+		 *
+		 * @throws std::runtime_error If the snapshot cannot be read, was written by an incompatible version or
+		 * platform, or is malformed.
+		 */
+		[[nodiscard]] static Registry Map(const std::string& _path) {
+			
+			Registry result { Unseeded{} };
+			
+#if defined(__unix__) || defined(__APPLE__)
+			
+			const int fd = ::open(_path.c_str(), O_RDONLY);
+			
+			if (fd == -1) {
+				throw std::runtime_error("Could not open \"" + _path + "\".");
+			}
+			
+			struct stat info{};
+			
+			if (::fstat(fd, &info) == -1 || info.st_size <= 0) {
+				::close(fd);
+				throw std::runtime_error("Could not stat \"" + _path + "\".");
+			}
+			
+			const auto size = static_cast<size_t>(info.st_size);
+			
+			void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+			::close(fd);
+			
+			if (mapping == MAP_FAILED) {
+				throw std::runtime_error("Could not map \"" + _path + "\".");
+			}
+			
+			const std::shared_ptr<const void> storage(mapping, [size](const void* _mapping) {
+				::munmap(const_cast<void*>(_mapping), size);
+			});
+			
+			result.Attach(static_cast<const char*>(mapping), size, storage);
+#else
+			std::ifstream file(_path, std::ios::binary | std::ios::ate);
+			
+			if (!file) {
+				throw std::runtime_error("Could not open \"" + _path + "\".");
+			}
+			
+			const auto size = static_cast<size_t>(file.tellg());
+			
+			// Over-aligned, so that the tables are as aligned in memory as they are in the file.
+			auto storage = std::make_shared<std::vector<std::max_align_t>>((size / sizeof(std::max_align_t)) + 1U);
+			
+			file.seekg(0);
+			file.read(reinterpret_cast<char*>(storage->data()), static_cast<std::streamsize>(size));
+			
+			if (!file) {
+				throw std::runtime_error("Could not read \"" + _path + "\".");
+			}
+			
+			result.Attach(reinterpret_cast<const char*>(storage->data()), size, storage);
+#endif
+			
+			return result;
+		}
+	
+	private:
+		
+		/* Marks an unoccupied slot of the perfect hash. */
+		static constexpr uint32_t s_Empty = UINT32_MAX;
+		
+		struct StagedUnit final {
+			
+			std::vector<std::string> m_Names;
+			
+			std::string m_Reference;
+			
+			conversion_scalar_t m_Scale  { 1.0L };
+			conversion_scalar_t m_Offset { 0.0L };
+			
+			size_t m_Line { 0U };
+			
+			bool m_Resolved { false };
+		};
+		
+		struct StagedDimension final {
+			
+			std::string m_Name;
+			
+			std::vector<StagedUnit> m_Units;
+		};
+		
+		/* A string in the pool. */
+		struct PoolString final {
+			
+			uint32_t m_Offset;
+			uint32_t m_Length;
+		};
+		
+		struct DimensionEntry final {
+			
+			PoolString m_Name;
+			
+			uint32_t m_Units;     // Index of the first unit of the dimension.
+			uint32_t m_UnitCount;
+			uint32_t m_Plans;     // Index of the first Plan of the dimension's matrix.
+		};
+		
+		struct AliasEntry final {
+			
+			PoolString m_Name;
+			
+			uint16_t m_Dimension;
+			uint16_t m_Unit;
+		};
+		
+		/* A read-only view of a compiled table. */
+		template<typename T>
+		struct Span final {
+			
+			using value_t = T;
+			
+			const T* m_Data { nullptr };
+			size_t   m_Size { 0U };
+			
+			[[nodiscard]] constexpr size_t size()  const noexcept { return m_Size;       }
+			[[nodiscard]] constexpr bool   empty() const noexcept { return m_Size == 0U; }
+			
+			[[nodiscard]] constexpr const T* begin() const noexcept { return m_Data;          }
+			[[nodiscard]] constexpr const T* end()   const noexcept { return m_Data + m_Size; }
+			
+			[[nodiscard]] constexpr const T& operator[](const size_t& _index) const noexcept { return m_Data[_index]; }
+			
+			[[nodiscard]] const T& at(const size_t& _index) const {
+				
+				if (_index >= m_Size) {
+					throw std::out_of_range("Index out of range.");
+				}
+				
+				return m_Data[_index];
+			}
+		};
+		
+		/* Compiled tables owned by the Registry, as opposed to mapped from a snapshot. */
+		struct Storage final {
+			
+			std::string                    m_Pool;
+			std::vector<DimensionEntry>    m_Dimensions;
+			std::vector<PoolString>        m_Symbols;
+			std::vector<AliasEntry>        m_Aliases;
+			std::vector<Conversions::Plan> m_Plans;
+			std::vector<Conversions::Plan> m_Bases;
+			std::vector<uint32_t>          m_Displacements;
+			std::vector<uint32_t>          m_Slots;
+			uint64_t                       m_Seed { 0U };
+		};
+		
+		struct SnapshotSection final {
+			
+			uint64_t m_Offset;
+			uint64_t m_Count;
+		};
+		
+		struct SnapshotHeader final {
+			
+			char     m_Magic[8];
+			uint32_t m_Version;
+			uint32_t m_Endianness;
+			uint32_t m_ScalarSize;
+			uint32_t m_ScalarDigits;
+			uint64_t m_Size;
+			uint64_t m_Seed;
+			
+			SnapshotSection m_Pool;
+			SnapshotSection m_Dimensions;
+			SnapshotSection m_Symbols;
+			SnapshotSection m_Aliases;
+			SnapshotSection m_Plans;
+			SnapshotSection m_Bases;
+			SnapshotSection m_Displacements;
+			SnapshotSection m_Slots;
+		};
+		
+		static_assert(std::is_trivially_copyable_v<DimensionEntry> &&
+		              std::is_trivially_copyable_v<AliasEntry>     &&
+		              std::is_trivially_copyable_v<Conversions::Plan>, "Snapshot tables must be trivially copyable.");
+		
+		static constexpr char     s_Magic[8]   = { 'L', 'E', 'U', 'N', 'I', 'T', 'S', '\0' };
+		static constexpr uint32_t s_Version    = 1U;
+		static constexpr uint32_t s_Endianness = 0x01020304U;
+		
+		/* The bytes of a scalar which hold its value. x87 extended precision pads its 10 bytes to 12 or 16. */
+		static constexpr size_t s_ScalarBytes =
+			std::numeric_limits<conversion_scalar_t>::digits == 64 ? 10U : sizeof(conversion_scalar_t);
+		
+		/* Tag for creating a Registry without the built-in dimensions. */
+		struct Unseeded final {};
+		
+		explicit Registry(const Unseeded& /*_tag*/) noexcept {}
+		
+		/* Definitions, from which the tables are compiled. Empty if the tables were mapped from a snapshot. */
+		std::vector<StagedDimension> m_Staged;
+		
+		/* Keeps the compiled tables alive. Shared between copies, as the tables are never modified in-place. */
+		std::shared_ptr<const void> m_Storage;
+		
+		/* Compiled tables. */
+		Span<char>              m_Pool;
+		Span<DimensionEntry>    m_Dimensions;
+		Span<PoolString>        m_Symbols;
+		Span<AliasEntry>        m_Aliases;
+		Span<Conversions::Plan> m_Plans;
+		Span<Conversions::Plan> m_Bases;
+		Span<uint32_t>          m_Displacements;
+		Span<uint32_t>          m_Slots;
+		uint64_t                m_Seed { 0U };
+		
+		template<typename TDimension>
+		void Seed(const typename TDimension::Unit& _base) {
+			
+			StagedDimension dimension { Conversions::Name<TDimension>(), std::vector<StagedUnit>(TDimension::s_Count) };
+			
+			for (size_t i = 0U; i < TDimension::s_Count; ++i) {
+				
+				const auto unit = static_cast<typename TDimension::Unit>(i);
+				const auto plan = Conversions::Plan::Make<TDimension>(unit, _base);
+				
+				auto& staged = dimension.m_Units[i];
+				staged.m_Names.emplace_back(TDimension::Symbol(unit));
+				staged.m_Scale    = plan.m_Scale;
+				staged.m_Offset   = plan.m_Offset;
+				staged.m_Resolved = true;
+			}
+			
+			for (const auto& alias : TDimension::Aliases()) {
+				
+				auto& names = dimension.m_Units[alias.second].m_Names;
+				
+				if (std::find(names.begin(), names.end(), alias.first) == names.end()) {
+					names.emplace_back(alias.first);
+				}
+			}
+			
+			m_Staged.push_back(std::move(dimension));
+		}
+		
+		/* Resolves every unit of a dimension to a direct factor against its base unit. */
+		static void Flatten(StagedDimension& _dimension, const std::string& _source) {
+			
+			std::vector<size_t> chain;
+			
+			for (size_t i = 0U; i < _dimension.m_Units.size(); ++i) {
+				
+				// Walk the chain of references until reaching a resolved unit...
+				for (auto current = i; !_dimension.m_Units[current].m_Resolved;) {
+					
+					auto& unit = _dimension.m_Units[current];
+					
+					const auto fail = [&](const std::string& _message) {
+						throw std::runtime_error(_source + ":" + std::to_string(unit.m_Line) + ": " + _message);
+					};
+					
+					if (unit.m_Reference.empty()) {
+						unit.m_Resolved = true;
+						break;
+					}
+					
+					if (std::find(chain.begin(), chain.end(), current) != chain.end()) {
+						fail("\"" + unit.m_Names.front() + "\" is defined in terms of itself.");
+					}
+					
+					chain.push_back(current);
+					
+					const auto reference = FindUnit(_dimension, unit.m_Reference);
+					
+					if (!reference) {
+						fail("Unknown unit \"" + unit.m_Reference + "\" in " + _dimension.m_Name + ".");
+					}
+					
+					current = *reference;
+				}
+				
+				// ...then fold the factors back down the chain.
+				while (!chain.empty()) {
+					
+					auto& unit = _dimension.m_Units[chain.back()];
+					const auto& reference = _dimension.m_Units[*FindUnit(_dimension, unit.m_Reference)];
+					
+					unit.m_Offset   = (reference.m_Scale * unit.m_Offset) + reference.m_Offset;
+					unit.m_Scale    =  reference.m_Scale * unit.m_Scale;
+					unit.m_Resolved = true;
+					
+					chain.pop_back();
+				}
+			}
+		}
+		
+		/* Compiles the tables from definitions, replacing the current tables only once it has succeeded. */
+		void Compile(const std::vector<StagedDimension>& _staged) {
+			
+			auto storage = std::make_shared<Storage>();
+			
+			if (_staged.size() > UINT16_MAX) {
+				throw std::length_error("Too many dimensions.");
+			}
+			
+			for (size_t d = 0U; d < _staged.size(); ++d) {
+				
+				const auto& staged = _staged[d];
+				const auto  count  = staged.m_Units.size();
+				
+				if (count > UINT16_MAX) {
+					throw std::length_error("Too many units.");
+				}
+				
+				storage->m_Dimensions.push_back({
+					Intern(*storage, staged.m_Name),
+					static_cast<uint32_t>(storage->m_Symbols.size()),
+					static_cast<uint32_t>(count),
+					static_cast<uint32_t>(storage->m_Plans.size())
+				});
+				
+				std::vector<std::string_view> names;
+				
+				for (size_t u = 0U; u < count; ++u) {
+					
+					const auto& unit = staged.m_Units[u];
+					
+					storage->m_Symbols.push_back(Intern(*storage, unit.m_Names.front()));
+					
+					Conversions::Plan base{};
+					base.m_Scale  = unit.m_Scale;
+					base.m_Offset = unit.m_Offset;
+					
+					storage->m_Bases.push_back(base);
+					
+					for (const auto& name : unit.m_Names) {
+						
+						// Where an alias is ambiguous within a dimension, the first unit to claim it wins.
+						if (std::find(names.begin(), names.end(), name) == names.end()) {
+							names.emplace_back(name);
+							
+							storage->m_Aliases.push_back({ Intern(*storage, name), static_cast<uint16_t>(d), static_cast<uint16_t>(u) });
+						}
+					}
+				}
+				
+				// Dense matrix of plans, composed as "from -> base -> to".
+				for (const auto& from : staged.m_Units) {
+					
+					for (const auto& to : staged.m_Units) {
+						
+						Conversions::Plan plan{};
+						plan.m_Scale  =  from.m_Scale / to.m_Scale;
+						plan.m_Offset = (from.m_Offset - to.m_Offset) / to.m_Scale;
+						
+						storage->m_Plans.push_back(plan);
+					}
+				}
+			}
+			
+			BuildPerfectHash(*storage);
+			
+			m_Pool          = { storage->m_Pool.data(),          storage->m_Pool.size()          };
+			m_Dimensions    = { storage->m_Dimensions.data(),    storage->m_Dimensions.size()    };
+			m_Symbols       = { storage->m_Symbols.data(),       storage->m_Symbols.size()       };
+			m_Aliases       = { storage->m_Aliases.data(),       storage->m_Aliases.size()       };
+			m_Plans         = { storage->m_Plans.data(),         storage->m_Plans.size()         };
+			m_Bases         = { storage->m_Bases.data(),         storage->m_Bases.size()         };
+			m_Displacements = { storage->m_Displacements.data(), storage->m_Displacements.size() };
+			m_Slots         = { storage->m_Slots.data(),         storage->m_Slots.size()         };
+			m_Seed          = storage->m_Seed;
+			m_Storage       = std::move(storage);
+		}
+		
+		/* Points the tables into a snapshot, after checking that it is compatible and well-formed. */
+		void Attach(const char* _data, const size_t& _size, std::shared_ptr<const void> _storage) {
+			
+			const auto fail = [](const std::string& _message) {
+				throw std::runtime_error("Invalid snapshot: " + _message);
+			};
+			
+			SnapshotHeader header{};
+			
+			if (_size < sizeof(header)) {
+				fail("Truncated header.");
+			}
+			
+			std::memcpy(&header, _data, sizeof(header));
+			
+			if (std::memcmp(header.m_Magic, s_Magic, sizeof(s_Magic)) != 0) {
+				fail("Not a snapshot.");
+			}
+			
+			if (header.m_Version != s_Version) {
+				fail("Unsupported version " + std::to_string(header.m_Version) + ".");
+			}
+			
+			if (header.m_Endianness   != s_Endianness                                     ||
+			    header.m_ScalarSize   != sizeof(conversion_scalar_t)                      ||
+			    header.m_ScalarDigits != std::numeric_limits<conversion_scalar_t>::digits
+			) {
+				fail("Written on an incompatible platform.");
+			}
+			
+			if (header.m_Size != _size) {
+				fail("Unexpected size.");
+			}
+			
+			const auto section = [&](const SnapshotSection& _section, auto& _table) {
+				
+				using value_t = typename std::decay_t<decltype(_table)>::value_t;
+				
+				if (_section.m_Offset % alignof(value_t) != 0U ||
+				    _section.m_Offset > _size                  ||
+				    _section.m_Count  > (_size - _section.m_Offset) / sizeof(value_t)
+				) {
+					fail("Table out of bounds.");
+				}
+				
+				_table = { reinterpret_cast<const value_t*>(_data + _section.m_Offset), static_cast<size_t>(_section.m_Count) };
+			};
+			
+			section(header.m_Pool,          m_Pool         );
+			section(header.m_Dimensions,    m_Dimensions   );
+			section(header.m_Symbols,       m_Symbols      );
+			section(header.m_Aliases,       m_Aliases      );
+			section(header.m_Plans,         m_Plans        );
+			section(header.m_Bases,         m_Bases        );
+			section(header.m_Displacements, m_Displacements);
+			section(header.m_Slots,         m_Slots        );
+			
+			m_Seed = header.m_Seed;
+			
+			// Check every index, so that lookups into a malformed snapshot cannot read out of bounds.
+			const auto valid = [this](const PoolString& _string) {
+				return _string.m_Offset <= m_Pool.size() && _string.m_Length <= m_Pool.size() - _string.m_Offset;
+			};
+			
+			if (m_Dimensions.size() > UINT16_MAX || m_Symbols.size() != m_Bases.size() || m_Slots.empty() != m_Displacements.empty()) {
+				fail("Inconsistent tables.");
+			}
+			
+			for (const auto& dimension : m_Dimensions) {
+				
+				const auto units = static_cast<uint64_t>(dimension.m_UnitCount);
+				
+				if (!valid(dimension.m_Name)                                              ||
+				    dimension.m_Units + units                > m_Symbols.size()          ||
+				    dimension.m_Plans + (units * units)      > m_Plans.size()
+				) {
+					fail("Dimension out of bounds.");
+				}
+			}
+			
+			for (const auto& symbol : m_Symbols) {
+				
+				if (!valid(symbol)) {
+					fail("Symbol out of bounds.");
+				}
+			}
+			
+			for (const auto& alias : m_Aliases) {
+				
+				if (!valid(alias.m_Name) || alias.m_Dimension >= m_Dimensions.size() || alias.m_Unit >= m_Dimensions[alias.m_Dimension].m_UnitCount) {
+					fail("Alias out of bounds.");
+				}
+			}
+			
+			for (const auto& slot : m_Slots) {
+				
+				if (slot != s_Empty && slot >= m_Aliases.size()) {
+					fail("Slot out of bounds.");
+				}
+			}
+			
+			m_Storage = std::move(_storage);
+		}
+		
+		/* Recovers the definitions from the compiled tables, so that a mapped Registry can be extended. */
+		[[nodiscard]] std::vector<StagedDimension> Thaw() const {
+			
+			std::vector<StagedDimension> result;
+			
+			for (const auto& dimension : m_Dimensions) {
+				
+				StagedDimension staged { std::string(String(dimension.m_Name)), std::vector<StagedUnit>(dimension.m_UnitCount) };
+				
+				for (size_t u = 0U; u < dimension.m_UnitCount; ++u) {
+					
+					const auto& base = m_Bases[dimension.m_Units + u];
+					
+					auto& unit = staged.m_Units[u];
+					unit.m_Names.emplace_back(String(m_Symbols[dimension.m_Units + u]));
+					unit.m_Scale    = base.m_Scale;
+					unit.m_Offset   = base.m_Offset;
+					unit.m_Resolved = true;
+				}
+				
+				result.push_back(std::move(staged));
+			}
+			
+			for (const auto& alias : m_Aliases) {
+				
+				auto& names = result[alias.m_Dimension].m_Units[alias.m_Unit].m_Names;
+				
+				if (const auto name = String(alias.m_Name); std::find(names.begin(), names.end(), name) == names.end()) {
+					names.emplace_back(name);
+				}
+			}
+			
+			return result;
+		}
+		
+		/*
+		 * Builds a hash-and-displace perfect hash over the aliases: keys are grouped into buckets by their hash, and
+		 * each bucket (largest first) is given a displacement which places all of its keys into unoccupied slots.
+		 */
+		static void BuildPerfectHash(Storage& _storage) {
+			
+			auto& seed          = _storage.m_Seed;
+			auto& displacements = _storage.m_Displacements;
+			auto& slots         = _storage.m_Slots;
+			
+			const auto count = _storage.m_Aliases.size();
+			
+			const auto bucket_count = std::max<size_t>(1U, (count + 3U) / 4U);
+			const auto slot_count   = std::max<size_t>(1U, count + (count / 4U));
+			
+			std::vector<uint64_t> hashes(count);
+			
+			for (seed = 0U;; ++seed) {
+				
+				if (seed == 64U) {
+					throw std::runtime_error("Failed to build a perfect hash over the aliases.");
+				}
+				
+				for (size_t i = 0U; i < count; ++i) {
+					
+					const auto& alias = _storage.m_Aliases[i];
+					
+					hashes[i] = Hash(alias.m_Dimension, { _storage.m_Pool.data() + alias.m_Name.m_Offset, alias.m_Name.m_Length }, seed);
+				}
+				
+				std::vector<std::vector<uint32_t>> buckets(bucket_count);
+				
+				for (size_t i = 0U; i < count; ++i) {
+					buckets[hashes[i] % bucket_count].push_back(static_cast<uint32_t>(i));
+				}
+				
+				std::vector<uint32_t> order(bucket_count);
+				
+				for (size_t i = 0U; i < bucket_count; ++i) {
+					order[i] = static_cast<uint32_t>(i);
+				}
+				
+				std::stable_sort(order.begin(), order.end(), [&buckets](const uint32_t& _a, const uint32_t& _b) {
+					return buckets[_a].size() > buckets[_b].size();
+				});
+				
+				displacements.assign(bucket_count, 0U);
+				slots.assign(slot_count, s_Empty);
+				
+				bool success = true;
+				
+				std::vector<size_t> placed;
+				
+				for (const auto& b : order) {
+					
+					const auto& bucket = buckets[b];
+					
+					if (bucket.empty()) {
+						break;
+					}
+					
+					bool found = false;
+					
+					for (uint32_t displacement = 0U; displacement < (1U << 16U) && !found; ++displacement) {
+						
+						placed.clear();
+						found = true;
+						
+						for (const auto& key : bucket) {
+							
+							const auto slot = Slot(hashes[key], displacement, slot_count);
+							
+							if (slots[slot] != s_Empty) {
+								found = false;
+								break;
+							}
+							
+							slots[slot] = key;
+							placed.push_back(slot);
+						}
+						
+						if (found) {
+							displacements[b] = displacement;
+						}
+						else {
+							for (const auto& slot : placed) {
+								slots[slot] = s_Empty;
+							}
+						}
+					}
+					
+					if (!found) {
+						success = false;
+						break;
+					}
+				}
+				
+				if (success) {
+					break;
+				}
+			}
+		}
+		
+		static PoolString Intern(Storage& _storage, const std::string_view& _string) {
+			
+			const PoolString result { static_cast<uint32_t>(_storage.m_Pool.size()), static_cast<uint32_t>(_string.size()) };
+			_storage.m_Pool.append(_string);
+			
+			return result;
+		}
+		
+		[[nodiscard]] std::string_view String(const PoolString& _string) const noexcept {
+			return { m_Pool.begin() + _string.m_Offset, _string.m_Length };
+		}
+		
+		[[nodiscard]] static constexpr size_t Align(const size_t& _offset) noexcept {
+			return (_offset + alignof(std::max_align_t) - 1U) & ~(alignof(std::max_align_t) - 1U);
+		}
+		
+		/* FNV-1a over the symbol, seeded by the dimension, with a final avalanche. */
+		[[nodiscard]] static constexpr uint64_t Hash(const uint16_t& _dimension, const std::string_view& _symbol, const uint64_t& _seed) noexcept {
+			
+			uint64_t result = 0xCBF29CE484222325ULL ^ Mix(((_seed + 1U) * 0x9E3779B97F4A7C15ULL) + _dimension);
+			
+			for (const auto& c : _symbol) {
+				result ^= static_cast<unsigned char>(c);
+				result *= 0x100000001B3ULL;
+			}
+			
+			return Mix(result);
+		}
+		
+		[[nodiscard]] static constexpr uint64_t Mix(uint64_t _value) noexcept {
+			
+			_value ^= _value >> 30U; _value *= 0xBF58476D1CE4E5B9ULL;
+			_value ^= _value >> 27U; _value *= 0x94D049BB133111EBULL;
+			_value ^= _value >> 31U;
+			
+			return _value;
+		}
+		
+		[[nodiscard]] static constexpr size_t Slot(const uint64_t& _hash, const uint32_t& _displacement, const size_t& _slot_count) noexcept {
+			return static_cast<size_t>(((_hash >> 32U) ^ Mix(_hash + _displacement)) % _slot_count);
+		}
+		
+		[[nodiscard]] static bool ParseNumber(const std::string_view& _token, conversion_scalar_t& _result) {
+			
+			// Parsed at the precision of the built-in tables, rather than rounded through double.
+			conversion_scalar_t value{};
+			
+			const auto* const last = _token.data() + _token.size();
+			const auto [ptr, ec] = std::from_chars(_token.data(), last, value);
+			
+			if (ec != std::errc() || ptr != last) {
+				return false;
+			}
+			
+			_result = value;
+			
+			return true;
+		}
+		
+		[[nodiscard]] static std::string_view Trim(std::string_view _text) noexcept {
+			
+			constexpr std::string_view whitespace = " \t\r\n\v\f";
+			
+			const auto first = _text.find_first_not_of(whitespace);
+			
+			if (first == std::string_view::npos) {
+				return {};
+			}
+			
+			return _text.substr(first, _text.find_last_not_of(whitespace) - first + 1U);
+		}
+		
+		[[nodiscard]] static std::optional<size_t> Find(const std::vector<StagedDimension>& _staged, const std::string_view& _name) {
+			
+			for (size_t i = 0U; i < _staged.size(); ++i) {
+				
+				if (_staged[i].m_Name == _name) {
+					return i;
+				}
+			}
+			
+			return std::nullopt;
+		}
+		
+		[[nodiscard]] static std::optional<size_t> FindUnit(const StagedDimension& _dimension, const std::string_view& _name) {
+			
+			for (size_t i = 0U; i < _dimension.m_Units.size(); ++i) {
+				
+				const auto& names = _dimension.m_Units[i].m_Names;
+				
+				if (std::find(names.begin(), names.end(), _name) != names.end()) {
+					return i;
+				}
+			}
+			
+			return std::nullopt;
+		}
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_REGISTRY_HPP
@@ -0,0 +1,281 @@
+#ifndef LOUIERIKSSON_ROLLING_WINDOW_HPP
+#define LOUIERIKSSON_ROLLING_WINDOW_HPP
+
+#include "Conversions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @class RollingWindow
+	 * @brief The mean, minimum, maximum and variance of a stream over a sliding window of time.
+	 *
+	 * @details Samples are accumulated in the unit they arrive in, and the conversion into the requested unit is
+	 * applied only to the summary when it is read: affinely to the mean, minimum and maximum, and by the square of
+	 * the conversion factor to the variance. Minimum and maximum are tracked with monotonic queues, so every
+	 * operation is amortised constant time.
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * RollingWindow<Conversions::Pressure> window(5.0, Conversions::Time::Minute, Conversions::Time::Second, Conversions::Pressure::Hectopascal);
+	 *
+	 * window.Push(t, 1013.25); // t in seconds.
+	 *
+	 * if (window.Max(Conversions::Pressure::Kilopascal) > 105.0) { ... }
+	 * @endcode
+	 */
+	template<typename TDimension>
+	class RollingWindow final {
+	
+	public:
+		
+		using dimension_t = TDimension;
+		using unit_t      = typename TDimension::Unit;
+		
+		/**
+		 * @brief Creates an empty window.
+		 *
+		 * @param[in] _length The length of the window. Samples older than this are evicted.
+		 * @param[in] _lengthUnit The unit of _length.
+		 * @param[in] _clock The unit of the times samples are pushed with, into which _length is converted once.
+		 * @param[in] _unit The unit samples are pushed in.
+		 */
+		RollingWindow(const double& _length, const Conversions::Time::Unit& _lengthUnit, const Conversions::Time::Unit& _clock, const unit_t& _unit) :
+			m_Length(static_cast<double>(Conversions::Time::Convert(_length, _lengthUnit, _clock))),
+			m_Clock(_clock),
+			m_Unit(_unit),
+			m_Now(-std::numeric_limits<double>::infinity()),
+			m_Reference(0.0),
+			m_Sum(0.0),
+			m_SumOfSquares(0.0),
+			m_Evicted(0U)
+		{
+			if (!(m_Length > 0.0)) {
+				throw std::invalid_argument("Window length must be positive.");
+			}
+		}
+		
+		/** @brief Returns the length of the window, in the unit given by Clock(). */
+		[[nodiscard]] const double& Length() const noexcept { return m_Length; }
+		
+		/** @brief Returns the unit of the times samples are pushed with. */
+		[[nodiscard]] const Conversions::Time::Unit& Clock() const noexcept { return m_Clock; }
+		
+		/** @brief Returns the unit samples are pushed in. */
+		[[nodiscard]] const unit_t& Unit() const noexcept { return m_Unit; }
+		
+		/** @brief Returns the number of samples in the window. */
+		[[nodiscard]] size_t Count() const noexcept { return m_Samples.size(); }
+		
+		/**
+		 * @brief Adds a sample to the window, and evicts the samples which have left it.
+		 *
+		 * @param[in] _time The time of the sample, in the unit given by Clock(). Must not precede the time of any
+		 * previous sample.
+		 * @param[in] _value The sample, in the unit of the window. Must not be NaN.
+		 */
+		void Push(const double& _time, const double& _value) {
+			
+			// A NaN compares neither less nor greater than anything, so would break the ordering of the queues.
+			if (std::isnan(_value)) {
+				throw std::invalid_argument("Sample must not be NaN.");
+			}
+			
+			Advance(_time);
+			
+			if (m_Samples.empty()) {
+				m_Reference = _value;
+			}
+			
+			m_Samples.push_back({ _time, _value });
+			
+			const auto shifted = _value - m_Reference;
+			
+			m_Sum          += shifted;
+			m_SumOfSquares += shifted * shifted;
+			
+			while (!m_Min.empty() && m_Min.back().m_Value >= _value) { m_Min.pop_back(); }
+			while (!m_Max.empty() && m_Max.back().m_Value <= _value) { m_Max.pop_back(); }
+			
+			m_Min.push_back({ _time, _value });
+			m_Max.push_back({ _time, _value });
+		}
+		
+		/**
+		 * @brief Moves the window forward in time without adding a sample, evicting the samples which have left it.
+		 *
+		 * @param[in] _time The current time, in the unit given by Clock(). Must not precede the time of any previous
+		 * sample.
+		 */
+		void Advance(const double& _time) {
+			
+			if (!(_time >= m_Now)) {
+				throw std::invalid_argument("Time must not go backwards, or be NaN.");
+			}
+			
+			m_Now = _time;
+			
+			const auto cutoff = m_Now - m_Length;
+			
+			while (!m_Samples.empty() && m_Samples.front().m_Time <= cutoff) {
+				
+				const auto shifted = m_Samples.front().m_Value - m_Reference;
+				
+				m_Sum          -= shifted;
+				m_SumOfSquares -= shifted * shifted;
+				
+				m_Samples.pop_front();
+				
+				++m_Evicted;
+			}
+			
+			while (!m_Min.empty() && m_Min.front().m_Time <= cutoff) { m_Min.pop_front(); }
+			while (!m_Max.empty() && m_Max.front().m_Time <= cutoff) { m_Max.pop_front(); }
+			
+			// Discard any rounding error accumulated by eviction.
+			if (m_Samples.empty()) {
+				m_Sum          = 0.0;
+				m_SumOfSquares = 0.0;
+				m_Evicted      = 0U;
+			}
+			else if (m_Evicted >= m_Samples.size()) {
+				Rebase();
+			}
+		}
+		
+		/**
+		 * @brief Returns the mean of the samples in the window.
+		 *
+		 * @param[in] _unit The unit to return the mean in.
+		 * @return The mean, or NaN if the window is empty.
+		 */
+		[[nodiscard]] double Mean(const unit_t& _unit) const {
+			return Plan(_unit)(m_Samples.empty() ? s_NaN : m_Reference + (m_Sum / Samples()));
+		}
+		
+		/**
+		 * @brief Returns the minimum of the samples in the window.
+		 *
+		 * @param[in] _unit The unit to return the minimum in.
+		 * @return The minimum, or NaN if the window is empty.
+		 */
+		[[nodiscard]] double Min(const unit_t& _unit) const {
+			return Plan(_unit)(m_Min.empty() ? s_NaN : m_Min.front().m_Value);
+		}
+		
+		/**
+		 * @brief Returns the maximum of the samples in the window.
+		 *
+		 * @param[in] _unit The unit to return the maximum in.
+		 * @return The maximum, or NaN if the window is empty.
+		 */
+		[[nodiscard]] double Max(const unit_t& _unit) const {
+			return Plan(_unit)(m_Max.empty() ? s_NaN : m_Max.front().m_Value);
+		}
+		
+		/**
+		 * @brief Returns the (population) variance of the samples in the window.
+		 *
+		 * @param[in] _unit The unit to return the variance in, which is the square of this unit.
+		 * @return The variance, or NaN if the window is empty.
+		 */
+		[[nodiscard]] double Variance(const unit_t& _unit) const {
+			
+			if (m_Samples.empty()) {
+				return s_NaN;
+			}
+			
+			const auto mean  = m_Sum / Samples();
+			const auto scale = static_cast<double>(Plan(_unit).m_Scale);
+			
+			return std::max(0.0, (m_SumOfSquares / Samples()) - (mean * mean)) * (scale * scale);
+		}
+		
+		/** @brief Removes every sample from the window. */
+		void Clear() noexcept {
+			
+			m_Samples.clear();
+			m_Min.clear();
+			m_Max.clear();
+			
+			m_Now          = -std::numeric_limits<double>::infinity();
+			m_Sum          = 0.0;
+			m_SumOfSquares = 0.0;
+			m_Evicted      = 0U;
+		}
+	
+	private:
+		
+		struct Sample final {
+			
+			double m_Time;
+			double m_Value;
+		};
+		
+		inline static constexpr double s_NaN = std::numeric_limits<double>::quiet_NaN();
+		
+		double m_Length;
+		
+		Conversions::Time::Unit m_Clock;
+		
+		unit_t m_Unit;
+		
+		double m_Now;
+		
+		/*
+		 * Sums are taken relative to a reference near the samples, to limit cancellation in the variance. The
+		 * reference is moved to the mean, and the sums recomputed, once as many samples have been evicted as remain,
+		 * so that a stream which drifts or shifts in level does not accumulate rounding error.
+		 */
+		double m_Reference;
+		double m_Sum;
+		double m_SumOfSquares;
+		
+		/* The number of samples evicted since the sums were last recomputed. */
+		size_t m_Evicted;
+		
+		std::deque<Sample> m_Samples;
+		std::deque<Sample> m_Min;
+		std::deque<Sample> m_Max;
+		
+		[[nodiscard]] double Samples() const noexcept { return static_cast<double>(m_Samples.size()); }
+		
+		/* Moves the reference to the mean of the samples, and recomputes the sums relative to it. Amortised O(1). */
+		void Rebase() noexcept {
+			
+			double mean = 0.0;
+			
+			for (const auto& sample : m_Samples) {
+				mean += sample.m_Value;
+			}
+			
+			m_Reference    = mean / Samples();
+			m_Sum          = 0.0;
+			m_SumOfSquares = 0.0;
+			
+			for (const auto& sample : m_Samples) {
+				
+				const auto shifted = sample.m_Value - m_Reference;
+				
+				m_Sum          += shifted;
+				m_SumOfSquares += shifted * shifted;
+			}
+			
+			m_Evicted = 0U;
+		}
+		
+		[[nodiscard]] Conversions::Plan Plan(const unit_t& _unit) const {
+			return Conversions::Plan::Make<TDimension>(m_Unit, _unit);
+		}
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_ROLLING_WINDOW_HPP
@@ -0,0 +1,152 @@
+#ifndef LOUIERIKSSON_SYMBOL_FILTER_HPP
+#define LOUIERIKSSON_SYMBOL_FILTER_HPP
+
+#include "Conversions.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @class SymbolFilter
+	 * @brief A Bloom filter over every symbol recognised by the TryGuessUnit of any built-in dimension.
+	 *
+	 * @details Intended as a negative pre-check when scanning free text for units, where most tokens are not units:
+	 * MayContain rejects almost all of them before any hash table is consulted. A token is first rejected if no
+	 * symbol has its length, and otherwise hashed once and checked against a single 64-bit word of the filter (a
+	 * blocked Bloom filter), so a check costs one cache access. At 16 bits per symbol the whole filter is around a
+	 * kilobyte, and stays resident in L1.
+	 *
+	 * False positives are possible, so a token which passes must still be looked up; false negatives are not.
+	 *
+	 * @code
+	 * using namespace LouiEriksson::Maths;
+	 *
+	 * const SymbolFilter filter;
+	 *
+	 * for (const auto& token : tokens) {
+	 *
+	 *     if (filter.MayContain(token)) {
+	 *
+	 *         if (const auto unit = Conversions::Pressure::TryGuessUnit(std::string(token))) { ... }
+	 *     }
+	 * }
+	 * @endcode
+	 */
+	class SymbolFilter final {
+	
+	public:
+		
+		/** @brief Creates a filter over the symbols of every built-in dimension. */
+		SymbolFilter() :
+			m_Lengths(0U)
+		{
+			std::vector<std::string> symbols;
+			
+			Gather<Conversions::Speed>      (symbols);
+			Gather<Conversions::Distance>   (symbols);
+			Gather<Conversions::Rotation>   (symbols);
+			Gather<Conversions::Time>       (symbols);
+			Gather<Conversions::Temperature>(symbols);
+			Gather<Conversions::Pressure>   (symbols);
+			Gather<Conversions::Mass>       (symbols);
+			Gather<Conversions::Area>       (symbols);
+			Gather<Conversions::Volume>     (symbols);
+			
+			// A power of two of at least 16 bits per symbol.
+			size_t words = 1U;
+			
+			while (words * 64U < symbols.size() * s_BitsPerSymbol) {
+				words *= 2U;
+			}
+			
+			m_Words.assign(words, 0U);
+			
+			for (const auto& symbol : symbols) {
+				
+				const auto hash = Hash(symbol);
+				
+				m_Words[Word(hash)] |= Mask(hash);
+				m_Lengths           |= LengthBit(symbol.size());
+			}
+		}
+		
+		/**
+		 * @brief Checks whether a token may be a known symbol.
+		 *
+		 * @param[in] _token The token.
+		 * @return False if the token is certainly not a known symbol, otherwise true.
+		 */
+		[[nodiscard]] bool MayContain(const std::string_view& _token) const noexcept {
+			
+			if ((m_Lengths & LengthBit(_token.size())) == 0U) {
+				return false;
+			}
+			
+			const auto hash = Hash(_token);
+			const auto mask = Mask(hash);
+			
+			return (m_Words[Word(hash)] & mask) == mask;
+		}
+		
+		/** @brief Returns the size of the filter, in bytes. */
+		[[nodiscard]] size_t Bytes() const noexcept { return m_Words.size() * sizeof(uint64_t); }
+	
+	private:
+		
+		static constexpr size_t s_BitsPerSymbol = 16U;
+		
+		/** @brief Bit n is set if any symbol is n bytes long (bit 63 standing for 63 or more). */
+		uint64_t m_Lengths;
+		
+		std::vector<uint64_t> m_Words;
+		
+		template<typename TDimension>
+		static void Gather(std::vector<std::string>& _symbols) {
+			
+			for (const auto& alias : TDimension::Aliases()) {
+				_symbols.emplace_back(alias.first);
+			}
+		}
+		
+		[[nodiscard]] static constexpr uint64_t LengthBit(const size_t& _length) noexcept {
+			return uint64_t(1U) << std::min<size_t>(_length, 63U);
+		}
+		
+		/* FNV-1a, finalised with the mixer of splitmix64 so that every bit of the result depends on every byte. */
+		[[nodiscard]] static uint64_t Hash(const std::string_view& _token) noexcept {
+			
+			uint64_t result = 0xCBF29CE484222325ULL;
+			
+			for (const auto& c : _token) {
+				result = (result ^ static_cast<unsigned char>(c)) * 0x100000001B3ULL;
+			}
+			
+			result = (result ^ (result >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+			result = (result ^ (result >> 27U)) * 0x94D049BB133111EBULL;
+			
+			return result ^ (result >> 31U);
+		}
+		
+		[[nodiscard]] size_t Word(const uint64_t& _hash) const noexcept {
+			return static_cast<size_t>(_hash >> 32U) & (m_Words.size() - 1U);
+		}
+		
+		/* Four bits within the word, taken from the low half of the hash. */
+		[[nodiscard]] static constexpr uint64_t Mask(const uint64_t& _hash) noexcept {
+			
+			return (uint64_t(1U) << ( _hash         & 63U)) |
+			       (uint64_t(1U) << ((_hash >>  6U) & 63U)) |
+			       (uint64_t(1U) << ((_hash >> 12U) & 63U)) |
+			       (uint64_t(1U) << ((_hash >> 18U) & 63U));
+		}
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_SYMBOL_FILTER_HPP
@@ -0,0 +1,307 @@
+#ifndef LOUIERIKSSON_TIMESTAMPS_HPP
+#define LOUIERIKSSON_TIMESTAMPS_HPP
+
+#include "Conversions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+	#include <immintrin.h>
+#endif
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @brief Contains exact integer conversions of epoch timestamps between units of time.
+	 *
+	 * @details Time::Convert works in Conversions::conversion_scalar_t, which cannot represent present-day epoch
+	 * timestamps to the nanosecond. Every unit of time is a whole number of nanoseconds, so timestamps can instead
+	 * be converted exactly with a single integer multiply (to a finer unit) or floor division (to a coarser unit).
+	 *
+	 * Each pair of units has its own kernel with a constant factor, so divisions compile to multiplications.
+	 * Multiplications are vectorised with AVX-512 or AVX2 where the target supports them. Divisions are vectorised
+	 * with AVX-512DQ only, as AVX2 has no conversions between 64-bit integers and doubles, and are otherwise scalar.
+	 */
+	struct Timestamps final {
+	
+	public:
+		
+		using Unit = Conversions::Time::Unit;
+		
+		/**
+		 * @brief Returns the number of nanoseconds in a unit of time.
+		 *
+		 * @param[in] _unit The unit of time.
+		 * @return The number of nanoseconds.
+		 */
+		[[nodiscard]] static constexpr int64_t Nanoseconds(const Unit& _unit) {
+			return s_Nanoseconds.at(_unit);
+		}
+		
+		/**
+		 * @brief Converts a timestamp between units of time exactly.
+		 *
+		 * @param[in] _value The timestamp to convert.
+		 * @param[in] _from The unit of the timestamp.
+		 * @param[in] _to The unit to convert to.
+		 * @return The converted timestamp, rounded towards negative infinity.
+		 *
+		 * @throw std::overflow_error If the result cannot be represented.
+		 */
+		[[nodiscard]] static constexpr int64_t Convert(const int64_t& _value, const Unit& _from, const Unit& _to) {
+			
+			const auto from = Nanoseconds(_from);
+			const auto to   = Nanoseconds(_to);
+			
+			if (from >= to) {
+				
+				const auto factor = from / to;
+				
+				if (_value > std::numeric_limits<int64_t>::max() / factor ||
+				    _value < std::numeric_limits<int64_t>::min() / factor
+				) {
+					throw std::overflow_error("Timestamp overflows the target unit.");
+				}
+				
+				return _value * factor;
+			}
+			
+			return FloorDivide(_value, to / from);
+		}
+		
+		/**
+		 * @brief Converts a column of timestamps between units of time exactly.
+		 *
+		 * @param[in] _in Pointer to the first timestamp.
+		 * @param[out] _out Destination for the converted timestamps. May be the same as _in.
+		 * @param[in] _size The number of timestamps.
+		 * @param[in] _from The unit of the timestamps.
+		 * @param[in] _to The unit to convert to.
+		 *
+		 * @throw std::overflow_error If any result cannot be represented, in which case the contents of _out are
+		 * unspecified.
+		 *
+		 * @note Results are rounded towards negative infinity, so timestamps before the epoch round to the start of
+		 * the unit containing them.
+		 */
+		static void Convert(const int64_t* _in, int64_t* _out, const size_t& _size, const Unit& _from, const Unit& _to) {
+			
+			/* The kernel for each pair of units, indexed by (from * count) + to. */
+			static const auto s_Kernels = MakeKernels(std::make_index_sequence<Conversions::Time::s_Count * Conversions::Time::s_Count>{});
+			
+			if (s_Kernels.at((static_cast<size_t>(_from) * Conversions::Time::s_Count) + _to)(_in, _out, _size)) {
+				throw std::overflow_error("Timestamp overflows the target unit.");
+			}
+		}
+		
+		/**
+		 * @brief Guesses whether a column of epoch timestamps is in seconds, milliseconds, microseconds or nanoseconds.
+		 *
+		 * @details The guess is made from the largest magnitude among (up to) 1024 evenly spaced timestamps. Epoch
+		 * timestamps between 1973 and 5138 differ in magnitude by a factor of at least 1000 between these units, so
+		 * the guess is unambiguous within that range.
+		 *
+		 * @param[in] _data Pointer to the first timestamp.
+		 * @param[in] _size The number of timestamps.
+		 * @return The most likely unit of the timestamps.
+		 *
+		 * @throw std::invalid_argument If the column is empty.
+		 */
+		[[nodiscard]] static Unit DetectEpochUnit(const int64_t* _data, const size_t& _size) {
+			
+			if (_size == 0U) {
+				throw std::invalid_argument("Cannot detect the unit of an empty column.");
+			}
+			
+			const auto step = std::max<size_t>(_size / 1024U, 1U);
+			
+			uint64_t magnitude = 0U;
+			
+			for (size_t i = 0U; i < _size; i += step) {
+				
+				const auto value = static_cast<uint64_t>(_data[i]);
+				
+				magnitude = std::max(magnitude, _data[i] < 0 ? 0U - value : value);
+			}
+			
+			if (magnitude < 100000000000ULL)       { return Conversions::Time::Second;      }
+			if (magnitude < 100000000000000ULL)    { return Conversions::Time::Millisecond; }
+			if (magnitude < 100000000000000000ULL) { return Conversions::Time::Microsecond; }
+			
+			return Conversions::Time::Nanosecond;
+		}
+	
+	private:
+		
+		using kernel_t = bool (*)(const int64_t*, int64_t*, size_t);
+		
+		inline static constexpr std::array<int64_t, Conversions::Time::s_Count> s_Nanoseconds {
+			1LL,
+			1000LL,
+			1000000LL,
+			1000000000LL,
+			60000000000LL,
+			3600000000000LL,
+			86400000000000LL,
+		};
+		
+		[[nodiscard]] static constexpr int64_t FloorDivide(const int64_t& _value, const int64_t& _divisor) noexcept {
+			
+			const auto quotient = _value / _divisor;
+			
+			return quotient - ((quotient * _divisor) > _value ? 1 : 0);
+		}
+		
+		/* Returns true if any value overflowed. */
+		template<size_t From, size_t To>
+		static bool Kernel(const int64_t* _in, int64_t* _out, size_t _size) noexcept {
+			
+			constexpr auto from = s_Nanoseconds[From];
+			constexpr auto to   = s_Nanoseconds[To];
+			
+			if constexpr (from == to) {
+				
+				if (_in != _out) {
+					std::memmove(_out, _in, _size * sizeof(int64_t));
+				}
+				
+				return false;
+			}
+			else if constexpr (from > to) {
+				return Multiply<from / to>(_in, _out, _size);
+			}
+			else {
+				
+				Divide<to / from>(_in, _out, _size);
+				
+				return false;
+			}
+		}
+		
+		template<int64_t Factor>
+		static bool Multiply(const int64_t* _in, int64_t* _out, size_t _size) noexcept {
+			
+			constexpr auto max = std::numeric_limits<int64_t>::max() / Factor;
+			constexpr auto min = std::numeric_limits<int64_t>::min() / Factor;
+			
+			bool overflow = false;
+			size_t i = 0U;
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+			{
+				const auto factor = _mm512_set1_epi64(Factor);
+				const auto upper  = _mm512_set1_epi64(max);
+				const auto lower  = _mm512_set1_epi64(min);
+				
+				__mmask8 flags = 0U;
+				
+				for (; i + 8U <= _size; i += 8U) {
+					
+					const auto value = _mm512_loadu_si512(_in + i);
+					
+					flags = static_cast<__mmask8>(flags | _mm512_cmpgt_epi64_mask(value, upper) | _mm512_cmplt_epi64_mask(value, lower));
+					
+					_mm512_storeu_si512(_out + i, _mm512_mullo_epi64(value, factor));
+				}
+				
+				overflow |= flags != 0U;
+			}
+#elif defined(__AVX2__)
+			{
+				// AVX2 has no 64-bit multiply, so the product is assembled from 32-bit partial products. The low 64
+				// bits of the product are the same whether the operands are signed or unsigned.
+				const auto factor_lo = _mm256_set1_epi64x(Factor & 0xFFFFFFFFLL);
+				const auto factor_hi = _mm256_set1_epi64x(static_cast<int64_t>(static_cast<uint64_t>(Factor) >> 32U));
+				const auto upper     = _mm256_set1_epi64x(max);
+				const auto lower     = _mm256_set1_epi64x(min);
+				
+				auto flags = _mm256_setzero_si256();
+				
+				for (; i + 4U <= _size; i += 4U) {
+					
+					const auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_in + i));
+					
+					flags = _mm256_or_si256(flags, _mm256_or_si256(_mm256_cmpgt_epi64(value, upper), _mm256_cmpgt_epi64(lower, value)));
+					
+					const auto lo_lo = _mm256_mul_epu32(value, factor_lo);
+					const auto hi_lo = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), factor_lo);
+					const auto lo_hi = _mm256_mul_epu32(value, factor_hi);
+					
+					const auto product = _mm256_add_epi64(lo_lo, _mm256_slli_epi64(_mm256_add_epi64(hi_lo, lo_hi), 32));
+					
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(_out + i), product);
+				}
+				
+				overflow |= _mm256_testz_si256(flags, flags) == 0;
+			}
+#endif
+			
+			for (; i < _size; ++i) {
+				
+				overflow |= _in[i] > max || _in[i] < min;
+				
+				_out[i] = static_cast<int64_t>(static_cast<uint64_t>(_in[i]) * static_cast<uint64_t>(Factor));
+			}
+			
+			return overflow;
+		}
+		
+		template<int64_t Divisor>
+		static void Divide(const int64_t* _in, int64_t* _out, size_t _size) noexcept {
+			
+			size_t i = 0U;
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+			{
+				// The quotient is estimated in double precision, which for any int64_t is within 64 of the true
+				// quotient, then refined from the remainder, which is small enough to be exact in double precision.
+				// The remainder is taken with wrapping arithmetic, as only its true value need be representable.
+				constexpr auto rounding = _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC;
+				
+				const auto divisor    = _mm512_set1_epi64(Divisor);
+				const auto reciprocal = _mm512_set1_pd(1.0 / static_cast<double>(Divisor));
+				const auto one        = _mm512_set1_epi64(1);
+				
+				for (; i + 8U <= _size; i += 8U) {
+					
+					const auto value = _mm512_loadu_si512(_in + i);
+					
+					auto quotient  = _mm512_cvt_roundpd_epi64(_mm512_mul_pd(_mm512_cvtepi64_pd(value), reciprocal), rounding);
+					auto remainder = _mm512_sub_epi64(value, _mm512_mullo_epi64(quotient, divisor));
+					
+					const auto refinement = _mm512_cvt_roundpd_epi64(_mm512_mul_pd(_mm512_cvtepi64_pd(remainder), reciprocal), rounding);
+					
+					quotient  = _mm512_add_epi64(quotient,  refinement);
+					remainder = _mm512_sub_epi64(remainder, _mm512_mullo_epi64(refinement, divisor));
+					
+					// The refinement may be one out where the product rounds across a whole number.
+					quotient = _mm512_mask_sub_epi64(quotient, _mm512_cmplt_epi64_mask(remainder, _mm512_setzero_si512()), quotient, one);
+					quotient = _mm512_mask_add_epi64(quotient, _mm512_cmpge_epi64_mask(remainder, divisor),                 quotient, one);
+					
+					_mm512_storeu_si512(_out + i, quotient);
+				}
+			}
+#endif
+			
+			for (; i < _size; ++i) {
+				_out[i] = FloorDivide(_in[i], Divisor);
+			}
+		}
+		
+		template<size_t... Indices>
+		static constexpr std::array<kernel_t, sizeof...(Indices)> MakeKernels(std::index_sequence<Indices...> /*unused*/) noexcept {
+			return { &Kernel<Indices / Conversions::Time::s_Count, Indices % Conversions::Time::s_Count>... };
+		}
+
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_TIMESTAMPS_HPP
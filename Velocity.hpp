@@ -0,0 +1,181 @@
+#ifndef LOUIERIKSSON_VELOCITY_HPP
+#define LOUIERIKSSON_VELOCITY_HPP
+
+#include "Conversions.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#endif
+
+namespace LouiEriksson::Maths {
+	
+	/**
+	 * @struct Velocity
+	 * @brief Conversion of velocities given as components to speeds in a unit of Conversions::Speed.
+	 *
+	 * @details The magnitude and the conversion are fused into a single pass: as the conversion factor is positive,
+	 * it is applied to the magnitude after the square root, so each element costs a sum of squares, a square root
+	 * and one multiply. The square root is vectorised with AVX2 where available.
+	 *
+	 * The sum of squares is only exact to within rounding while it is a normal, finite number. Elements whose sum of
+	 * squares overflows or underflows (components beyond roughly 1e154 or below 1e-154) are detected per lane and
+	 * recomputed with std::hypot, which scales to avoid both; they cost the same as any other element otherwise.
+	 */
+	struct Velocity final {
+		
+		/**
+		 * @brief Computes the speeds of two-dimensional velocities in a unit.
+		 *
+		 * @param[in] _x The first components.
+		 * @param[in] _y The second components.
+		 * @param[in] _size The number of velocities.
+		 * @param[in] _from The unit of the components.
+		 * @param[in] _to The unit to convert to.
+		 * @param[out] _out Destination for the speeds. Must hold _size values, and may alias any input.
+		 */
+		template<typename T>
+		static void Magnitude(const T* _x, const T* _y, const size_t& _size, const Conversions::Speed::Unit& _from, const Conversions::Speed::Unit& _to, T* _out) noexcept {
+			Magnitude<T, 2U>(_x, _y, nullptr, _size, _from, _to, _out);
+		}
+		
+		/**
+		 * @brief Computes the speeds of three-dimensional velocities in a unit.
+		 *
+		 * @param[in] _x The first components.
+		 * @param[in] _y The second components.
+		 * @param[in] _z The third components.
+		 * @param[in] _size The number of velocities.
+		 * @param[in] _from The unit of the components.
+		 * @param[in] _to The unit to convert to.
+		 * @param[out] _out Destination for the speeds. Must hold _size values, and may alias any input.
+		 *
+		 * @code
+		 * using namespace LouiEriksson::Maths;
+		 *
+		 * Velocity::Magnitude(vx.data(), vy.data(), vz.data(), vx.size(), Conversions::Speed::MetreSecond, Conversions::Speed::Knot, knots.data());
+		 * @endcode
+		 */
+		template<typename T>
+		static void Magnitude(const T* _x, const T* _y, const T* _z, const size_t& _size, const Conversions::Speed::Unit& _from, const Conversions::Speed::Unit& _to, T* _out) noexcept {
+			Magnitude<T, 3U>(_x, _y, _z, _size, _from, _to, _out);
+		}
+	
+	private:
+		
+		template<typename T, size_t Dimensions>
+		static void Magnitude(const T* _x, const T* _y, const T* _z, const size_t& _size, const Conversions::Speed::Unit& _from, const Conversions::Speed::Unit& _to, T* _out) noexcept {
+			
+			static_assert(std::is_floating_point_v<T>, "Velocity components must be of a floating-point type.");
+			
+			const auto scale = static_cast<T>(Conversions::Plan::Make<Conversions::Speed>(_from, _to).m_Scale);
+			
+			size_t i = 0U;
+
+#if defined(__AVX2__)
+			
+			if constexpr (std::is_same_v<T, double>) {
+				
+				const auto k   = _mm256_set1_pd(scale);
+				const auto min = _mm256_set1_pd(std::numeric_limits<double>::min());
+				const auto max = _mm256_set1_pd(std::numeric_limits<double>::max());
+				const auto nil = _mm256_setzero_pd();
+				
+				for (; i + 4U <= _size; i += 4U) {
+					
+					const auto x = _mm256_loadu_pd(_x + i);
+					const auto y = _mm256_loadu_pd(_y + i);
+					
+					auto xx = _mm256_mul_pd(x, x);
+					auto yy = _mm256_mul_pd(y, y);
+					Conversions::Round(xx);
+					Conversions::Round(yy);
+					
+					auto sum = _mm256_add_pd(xx, yy);
+					
+					// A sum of zero is exact only if every component is zero, rather than too small to square.
+					auto zero = _mm256_and_pd(_mm256_cmp_pd(x, nil, _CMP_EQ_OQ), _mm256_cmp_pd(y, nil, _CMP_EQ_OQ));
+					
+					if constexpr (Dimensions == 3U) {
+						
+						const auto z = _mm256_loadu_pd(_z + i);
+						
+						auto zz = _mm256_mul_pd(z, z);
+						Conversions::Round(zz);
+						
+						sum  = _mm256_add_pd(sum, zz);
+						zero = _mm256_and_pd(zero, _mm256_cmp_pd(z, nil, _CMP_EQ_OQ));
+					}
+					
+					auto result = _mm256_mul_pd(_mm256_sqrt_pd(sum), k);
+					
+					// Fall back to hypot for lanes which overflowed, underflowed, or are not finite.
+					const auto safe = _mm256_or_pd(_mm256_and_pd(_mm256_cmp_pd(sum, min, _CMP_GE_OQ), _mm256_cmp_pd(sum, max, _CMP_LE_OQ)), zero);
+					
+					if (auto mask = ~static_cast<unsigned>(_mm256_movemask_pd(safe)) & 0xFU; mask != 0U) {
+						
+						alignas(32) double lanes[4];
+						_mm256_store_pd(lanes, result);
+						
+						for (size_t lane = 0U; lane < 4U; ++lane, mask >>= 1U) {
+							
+							if ((mask & 1U) != 0U) {
+								lanes[lane] = Hypot<T, Dimensions>(_x, _y, _z, i + lane) * scale;
+							}
+						}
+						
+						result = _mm256_load_pd(lanes);
+					}
+					
+					// Stored only after the fallback has read its inputs, which _out may alias.
+					_mm256_storeu_pd(_out + i, result);
+				}
+			}
+#endif
+			
+			for (; i < _size; ++i) {
+				
+				auto xx = _x[i] * _x[i];
+				auto yy = _y[i] * _y[i];
+				Conversions::Round(xx);
+				Conversions::Round(yy);
+				
+				auto sum = xx + yy;
+				
+				// A sum of zero is exact only if every component is zero, rather than too small to square.
+				bool zero = _x[i] == T(0) && _y[i] == T(0);
+				
+				if constexpr (Dimensions == 3U) {
+					
+					auto zz = _z[i] * _z[i];
+					Conversions::Round(zz);
+					
+					sum  += zz;
+					zero &= _z[i] == T(0);
+				}
+				
+				_out[i] = ((sum >= std::numeric_limits<T>::min() && sum <= std::numeric_limits<T>::max()) || zero) ?
+					std::sqrt(sum)                       * scale :
+					Hypot<T, Dimensions>(_x, _y, _z, i) * scale;
+			}
+		}
+		
+		template<typename T, size_t Dimensions>
+		[[nodiscard]] static T Hypot(const T* _x, const T* _y, const T* _z, const size_t& _i) noexcept {
+			
+			if constexpr (Dimensions == 3U) {
+				return std::hypot(_x[_i], _y[_i], _z[_i]);
+			}
+			else {
+				return std::hypot(_x[_i], _y[_i]);
+			}
+		}
+	};
+	
+} // LouiEriksson::Maths
+
+#endif //LOUIERIKSSON_VELOCITY_HPP
@@ -0,0 +1,260 @@
+/*
+ * A loadable SQLite extension providing unit conversions:
+ *
+ *   convert(value, from_symbol, to_symbol)  Converts value between two units of the same dimension.
+ *   to_si(value, symbol)                    Converts value into the SI unit of its dimension.
+ *
+ * Symbols are resolved through a Registry of the built-in dimensions. When the symbol arguments are constant
+ * within a statement (the usual case), they are resolved once and the resulting Plan is cached on the statement
+ * with sqlite3_set_auxdata, so every row costs a single multiply-add.
+ *
+ * Build (the include paths being this repository and cpp-hashmap):
+ *
+ *   g++ -std=c++17 -O2 -shared -fPIC -I.. -I<cpp-hashmap> unitconversions.cpp -o unitconversions.so
+ *
+ * Load:
+ *
+ *   .load ./unitconversions
+ *   SELECT convert(speed, 'km/h', 'm/s') FROM readings;
+ */
+
+#include "../Registry.hpp"
+
+#include <sqlite3ext.h>
+
+#include <array>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+SQLITE_EXTENSION_INIT1
+
+namespace {
+	
+	using LouiEriksson::Maths::Conversions;
+	using LouiEriksson::Maths::Registry;
+	
+	/** @brief A Plan resolved for a statement, and the target symbol it was resolved against. */
+	struct CachedPlan final {
+		
+		Conversions::Plan m_Plan;
+		std::string       m_To;
+	};
+	
+	const Registry& Units() {
+		
+		static const Registry s_Registry;
+		
+		return s_Registry;
+	}
+	
+	/** @brief Returns the text of a value, or an empty optional if it is NULL. */
+	std::optional<std::string_view> Text(sqlite3_value* _value) {
+		
+		if (sqlite3_value_type(_value) == SQLITE_NULL) {
+			return std::nullopt;
+		}
+		
+		const auto* text = reinterpret_cast<const char*>(sqlite3_value_text(_value));
+		
+		return std::string_view(text, static_cast<size_t>(sqlite3_value_bytes(_value)));
+	}
+	
+	/**
+	 * @brief Finds the first dimension in which both symbols name a unit.
+	 *
+	 * @param[in] _from The symbol to convert from.
+	 * @param[in] _to The symbol to convert to.
+	 * @return The units, if such a dimension exists.
+	 */
+	std::optional<std::pair<Registry::Unit, Registry::Unit>> Resolve(const std::string_view& _from, const std::string_view& _to) {
+		
+		const auto& registry = Units();
+		
+		for (size_t i = 0U; i < registry.DimensionCount(); ++i) {
+			
+			const auto dimension = static_cast<uint16_t>(i);
+			
+			if (const auto from = registry.TryGuessUnit(dimension, _from)) {
+				
+				if (const auto to = registry.TryGuessUnit(dimension, _to)) {
+					return std::make_pair(*from, *to);
+				}
+			}
+		}
+		
+		return std::nullopt;
+	}
+	
+	/**
+	 * @brief Returns the symbol of the SI unit of the dimension of a symbol.
+	 *
+	 * @param[in] _symbol The symbol of any unit.
+	 * @return The symbol of the SI unit, if _symbol is recognised.
+	 */
+	std::optional<std::string_view> SymbolOfSI(const std::string_view& _symbol) {
+		
+		// The SI unit of each built-in dimension, in the order the Registry seeds them.
+		static constexpr std::array<unsigned char, 9U> s_SI {
+			Conversions::Speed::MetreSecond,
+			Conversions::Distance::Metre,
+			Conversions::Rotation::Radian,
+			Conversions::Time::Second,
+			Conversions::Temperature::Kelvin,
+			Conversions::Pressure::Pascal,
+			Conversions::Mass::Kilogram,
+			Conversions::Area::SquareMetre,
+			Conversions::Volume::CubicMetre,
+		};
+		
+		const auto& registry = Units();
+		
+		for (size_t i = 0U; i < s_SI.size(); ++i) {
+			
+			const auto dimension = static_cast<uint16_t>(i);
+			
+			if (registry.TryGuessUnit(dimension, _symbol).has_value()) {
+				return registry.Symbol({ dimension, s_SI[i] });
+			}
+		}
+		
+		return std::nullopt;
+	}
+	
+	/**
+	 * @brief Converts _value from the unit in argument _argument to the unit named _to, reusing the Plan cached on
+	 * that argument when its target matches.
+	 */
+	void ConvertWithCache(sqlite3_context* _context, sqlite3_value* _value, sqlite3_value* _from, const int& _argument, const std::string_view& _to) {
+		
+		const auto from = Text(_from);
+		
+		if (!from.has_value()) {
+			sqlite3_result_null(_context);
+			return;
+		}
+		
+		auto* cached = static_cast<CachedPlan*>(sqlite3_get_auxdata(_context, _argument));
+		
+		if (cached == nullptr || cached->m_To != _to) {
+			
+			const auto units = Resolve(*from, _to);
+			
+			if (!units.has_value()) {
+				
+				const auto message = "Cannot convert from \"" + std::string(*from) + "\" to \"" + std::string(_to) + "\".";
+				
+				sqlite3_result_error(_context, message.c_str(), -1);
+				return;
+			}
+			
+			cached = new (std::nothrow) CachedPlan { Units().GetPlan(units->first, units->second), std::string(_to) };
+			
+			if (cached == nullptr) {
+				sqlite3_result_error_nomem(_context);
+				return;
+			}
+			
+			// SQLite takes ownership, and may destroy it immediately if the argument is not constant.
+			sqlite3_set_auxdata(_context, _argument, cached, [](void* _cached) { delete static_cast<CachedPlan*>(_cached); });
+			
+			cached = static_cast<CachedPlan*>(sqlite3_get_auxdata(_context, _argument));
+			
+			if (cached == nullptr) {
+				
+				// Not retained, so convert with a Plan which will not be reused.
+				sqlite3_result_double(_context, static_cast<double>(Units().GetPlan(units->first, units->second)(sqlite3_value_double(_value))));
+				return;
+			}
+		}
+		
+		sqlite3_result_double(_context, static_cast<double>(cached->m_Plan(static_cast<Conversions::conversion_scalar_t>(sqlite3_value_double(_value)))));
+	}
+	
+	/* convert(value, from_symbol, to_symbol) */
+	void Convert(sqlite3_context* _context, int /*_argc*/, sqlite3_value** _argv) {
+		
+		try {
+			
+			const auto to = Text(_argv[2]);
+			
+			if (sqlite3_value_type(_argv[0]) == SQLITE_NULL || !to.has_value()) {
+				sqlite3_result_null(_context);
+				return;
+			}
+			
+			ConvertWithCache(_context, _argv[0], _argv[1], 1, *to);
+		}
+		catch (const std::exception& e) {
+			sqlite3_result_error(_context, e.what(), -1);
+		}
+	}
+	
+	/* to_si(value, symbol) */
+	void ToSI(sqlite3_context* _context, int /*_argc*/, sqlite3_value** _argv) {
+		
+		try {
+			
+			const auto from = Text(_argv[1]);
+			
+			if (sqlite3_value_type(_argv[0]) == SQLITE_NULL || !from.has_value()) {
+				sqlite3_result_null(_context);
+				return;
+			}
+			
+			// A cached Plan already knows its target, so only resolve the SI unit when there is none.
+			if (const auto* cached = static_cast<CachedPlan*>(sqlite3_get_auxdata(_context, 1))) {
+				sqlite3_result_double(_context, static_cast<double>(cached->m_Plan(static_cast<Conversions::conversion_scalar_t>(sqlite3_value_double(_argv[0])))));
+				return;
+			}
+			
+			const auto si = SymbolOfSI(*from);
+			
+			if (!si.has_value()) {
+				
+				const auto message = "Unrecognised unit \"" + std::string(*from) + "\".";
+				
+				sqlite3_result_error(_context, message.c_str(), -1);
+				return;
+			}
+			
+			ConvertWithCache(_context, _argv[0], _argv[1], 1, *si);
+		}
+		catch (const std::exception& e) {
+			sqlite3_result_error(_context, e.what(), -1);
+		}
+	}
+	
+} // namespace
+
+#ifdef _WIN32
+__declspec(dllexport)
+#endif
+extern "C" int sqlite3_unitconversions_init(sqlite3* _db, char** _error, const sqlite3_api_routines* _api) {
+	
+	SQLITE_EXTENSION_INIT2(_api);
+	
+	try {
+		
+		// Build the Registry now, rather than within the first query.
+		Units();
+	}
+	catch (const std::exception& e) {
+		*_error = sqlite3_mprintf("%s", e.what());
+		return SQLITE_ERROR;
+	}
+	
+	constexpr int flags = SQLITE_UTF8 | SQLITE_DETERMINISTIC | SQLITE_INNOCUOUS;
+	
+	int result = sqlite3_create_function(_db, "convert", 3, flags, nullptr, &Convert, nullptr, nullptr);
+	
+	if (result == SQLITE_OK) {
+		result = sqlite3_create_function(_db, "to_si", 2, flags, nullptr, &ToSI, nullptr, nullptr);
+	}
+	
+	return result;
+}
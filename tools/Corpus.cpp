@@ -0,0 +1,569 @@
+/*
+ * Generates synthetic benchmark inputs whose unit symbols are distributed like production traffic, as either a
+ * mixed-unit CSV (timestamp,sensor,value,unit) or a stream of symbols, one per line.
+ *
+ * Symbols are drawn from the aliases of every dimension (or of one, with --dimension) with Zipf-distributed
+ * frequencies, so that a few symbols dominate and the rest form a long tail. Which aliases are common is decided by
+ * the seed. A fraction of symbols (--variants) are rewritten into the equivalent form in the other encoding, such
+ * as "µm" as "um", "m²" as "m^2" or "m2", "deg" as "°", or the micro sign as a Greek mu, where the spelling is a whole
+ * prefix or suffix of the symbol, and otherwise change case.
+ * A further fraction (--typos) carry one typing error: a substitution, insertion, deletion or transposition. Neither
+ * is guaranteed to be recognised, which is the point.
+ *
+ * Output is streamed, so sizes are limited only by the disk, and stops at the last whole line within the given
+ * size, which accepts the suffixes K, M and G (powers of 1024). Generation depends only on the arguments, and not on
+ * the platform, compiler or standard library, so a seed reproduces the same bytes everywhere.
+ *
+ * Build and run (the include paths being this repository and cpp-hashmap):
+ *
+ *   g++ -std=c++17 -O2 -I.. -I<cpp-hashmap> Corpus.cpp -o corpus
+ *   ./corpus <csv|symbols> <size> [--seed=N] [--variants=P] [--typos=P] [--dimension=NAME] [--output=PATH]
+ *
+ * For example, "./corpus csv 20G --seed=7 --output=corpus.csv". The defaults are a seed of 42, 10% variants and 1%
+ * typos, and writing to the standard output.
+ */
+
+#include "../Conversions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+	
+	using LouiEriksson::Maths::Conversions;
+	
+	/**
+	 * @brief SplitMix64, used in place of the standard engines and distributions, whose output is
+	 * implementation-defined.
+	 */
+	struct Random final {
+		
+		uint64_t m_State;
+		
+		uint64_t Next() noexcept {
+			
+			auto z = (m_State += 0x9E3779B97F4A7C15ULL);
+			z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+			
+			return z ^ (z >> 31U);
+		}
+		
+		/** @brief Returns a value in [0, _bound). */
+		uint32_t Below(const uint32_t& _bound) noexcept {
+			return static_cast<uint32_t>(((Next() >> 32U) * _bound) >> 32U);
+		}
+		
+		/** @brief Returns a value in [0, 1). */
+		double Uniform() noexcept {
+			return static_cast<double>(Next() >> 11U) * 0x1.0p-53;
+		}
+		
+		bool Chance(const double& _probability) noexcept {
+			return Uniform() < _probability;
+		}
+	};
+	
+	struct Options final {
+		
+		bool m_CSV;
+		
+		uint64_t m_Size;
+		uint64_t m_Seed { 42U };
+		
+		double m_Variants { 0.1  };
+		double m_Typos    { 0.01 };
+		
+		std::string m_Dimension;
+		std::string m_Output;
+	};
+	
+	template<typename TDimension>
+	void Collect(const std::string& _dimension, std::vector<std::string>& _aliases) {
+		
+		if (_dimension.empty() || _dimension == Conversions::Name<TDimension>()) {
+			
+			for (const auto& alias : TDimension::Aliases()) {
+				_aliases.emplace_back(alias.first);
+			}
+		}
+	}
+	
+	/**
+	 * @brief Draws symbols from the aliases with Zipf-distributed frequencies.
+	 *
+	 * @details The aliases are sorted before being ranked, as the order of the lookup tables depends on the hash
+	 * function of the standard library. The exponent is one, so the weights need no call to pow, whose result may
+	 * differ between math libraries.
+	 */
+	struct Zipf final {
+		
+		std::vector<std::string> m_Aliases;
+		std::vector<double>      m_Cumulative;
+		
+		Zipf(std::vector<std::string> _aliases, Random& _random) : m_Aliases(std::move(_aliases)) {
+			
+			if (m_Aliases.empty()) {
+				throw std::runtime_error("No aliases to draw from.");
+			}
+			
+			std::sort(m_Aliases.begin(), m_Aliases.end());
+			m_Aliases.erase(std::unique(m_Aliases.begin(), m_Aliases.end()), m_Aliases.end());
+			
+			for (auto i = m_Aliases.size() - 1U; i > 0U; --i) {
+				std::swap(m_Aliases[i], m_Aliases[_random.Below(static_cast<uint32_t>(i + 1U))]);
+			}
+			
+			double total = 0.0;
+			
+			for (size_t i = 0U; i < m_Aliases.size(); ++i) {
+				m_Cumulative.emplace_back(total += 1.0 / static_cast<double>(i + 1U));
+			}
+		}
+		
+		const std::string& operator()(Random& _random) const noexcept {
+			
+			const auto it = std::upper_bound(m_Cumulative.begin(), m_Cumulative.end(), _random.Uniform() * m_Cumulative.back());
+			
+			return m_Aliases[std::min(static_cast<size_t>(it - m_Cumulative.begin()), m_Aliases.size() - 1U)];
+		}
+	};
+	
+	/** @brief Where in a symbol a spelling is written: before the unit it prefixes, or after the unit it follows. */
+	enum class Position : unsigned char {
+		Prefix,
+		Suffix,
+	};
+	
+	/** @brief A spelling of the same symbol in UTF-8 and ASCII, or in two look-alike code points. */
+	struct Variant final {
+		
+		std::string_view m_A;
+		std::string_view m_B;
+		Position         m_Position;
+	};
+	
+	constexpr std::array<Variant, 10U> s_Variants {{
+		{ "\xC2\xB5",     "u",        Position::Prefix }, // Micro sign.
+		{ "\xC2\xB5",     "\xCE\xBC", Position::Prefix }, // Micro sign and Greek mu.
+		{ "\xC2\xB0",     "deg",      Position::Prefix }, // Degree sign.
+		{ "\xC2\xB0",     "",         Position::Prefix },
+		{ "\xC2\xB2",     "^2",       Position::Suffix }, // Superscript two.
+		{ "\xC2\xB2",     "2",        Position::Suffix },
+		{ "\xC2\xB3",     "^3",       Position::Suffix }, // Superscript three.
+		{ "\xC2\xB3",     "3",        Position::Suffix },
+		{ "\xE2\x80\xB2", "'",        Position::Suffix }, // Prime.
+		{ "\xE2\x80\xB3", "\"",       Position::Suffix }, // Double prime.
+	}};
+	
+	[[nodiscard]] bool IsLetter(const char& _c) noexcept { return (_c >= 'a' && _c <= 'z') || (_c >= 'A' && _c <= 'Z'); }
+	
+	/**
+	 * @brief Returns whether a spelling written at the start or end of a symbol is a whole token of it, which may be
+	 * rewritten without producing a form nobody writes, such as "ft^\xC2\xB2" from "ft^2" or "\xC2\xB0rees" from "degrees".
+	 */
+	[[nodiscard]] bool IsToken(const std::string& _symbol, const std::string_view& _spelling, const Position& _position) {
+		
+		if (_position == Position::Prefix) {
+			
+			if (_symbol.compare(0U, _spelling.size(), _spelling) != 0) {
+				return false;
+			}
+			
+			// Followed by the symbol of a unit, of up to two letters (so not "ree" of "degree"), or by nothing.
+			const auto rest = std::string_view(_symbol).substr(_spelling.size());
+			
+			return rest.size() <= 2U && std::all_of(rest.begin(), rest.end(), IsLetter);
+		}
+		
+		if (_symbol.size() < _spelling.size() || _symbol.compare(_symbol.size() - _spelling.size(), _spelling.size(), _spelling) != 0) {
+			return false;
+		}
+		
+		// Preceded by the symbol of a unit, which ends in a letter or a prime (as in "'^3"), or by nothing.
+		const auto before = _symbol.size() - _spelling.size();
+		
+		return before == 0U || IsLetter(_symbol[before - 1U]) || _symbol[before - 1U] == '\'' || _symbol[before - 1U] == '"';
+	}
+	
+	/** @brief Rewrites one spelling in the symbol into the other, or changes its case if there is none. */
+	void Vary(std::string& _symbol, Random& _random) {
+		
+		const auto start = _random.Below(static_cast<uint32_t>(s_Variants.size()));
+		
+		for (size_t i = 0U; i < s_Variants.size(); ++i) {
+			
+			auto [a, b, position] = s_Variants[(start + i) % s_Variants.size()];
+			
+			if (_random.Chance(0.5)) {
+				std::swap(a, b);
+			}
+			
+			if (a.empty() || (b.empty() && a.size() == _symbol.size()) || !IsToken(_symbol, a, position)) {
+				continue;
+			}
+			
+			_symbol.replace(position == Position::Prefix ? 0U : _symbol.size() - a.size(), a.size(), b);
+			
+			return;
+		}
+		
+		const auto upper = _random.Chance(0.5);
+		
+		for (auto& c : _symbol) {
+			
+			if (upper && c >= 'a' && c <= 'z') { c = static_cast<char>(c - 'a' + 'A'); }
+			else if (!upper && c >= 'A' && c <= 'Z') { c = static_cast<char>(c - 'A' + 'a'); }
+		}
+	}
+	
+	/** @brief Introduces one typing error, at an ASCII character so that the symbol remains valid UTF-8. */
+	void Typo(std::string& _symbol, Random& _random) {
+		
+		size_t ascii[32];
+		size_t count = 0U;
+		
+		for (size_t i = 0U; i < _symbol.size() && count < std::size(ascii); ++i) {
+			
+			if (static_cast<unsigned char>(_symbol[i]) < 0x80U) {
+				ascii[count++] = i;
+			}
+		}
+		
+		const auto letter = static_cast<char>('a' + _random.Below(26U));
+		
+		if (count == 0U) {
+			_symbol += letter;
+			return;
+		}
+		
+		const auto at = ascii[_random.Below(static_cast<uint32_t>(count))];
+		
+		switch (_random.Below(4U)) {
+			case 0U: { _symbol[at] = letter;          break; }
+			case 1U: { _symbol.insert(at, 1U, letter); break; }
+			case 2U: {
+				
+				if (_symbol.size() > 1U) {
+					_symbol.erase(at, 1U);
+				}
+				else {
+					_symbol[at] = letter;
+				}
+				
+				break;
+			}
+			default: {
+				
+				if (at + 1U < _symbol.size() && static_cast<unsigned char>(_symbol[at + 1U]) < 0x80U) {
+					std::swap(_symbol[at], _symbol[at + 1U]);
+				}
+				else {
+					_symbol.insert(at, 1U, letter);
+				}
+				
+				break;
+			}
+		}
+	}
+	
+	/** @brief Writes an unsigned integer, returning the position after it. */
+	char* Write(char* _out, uint64_t _value, const size_t& _width = 1U) noexcept {
+		
+		char digits[20];
+		size_t count = 0U;
+		
+		do {
+			digits[count++] = static_cast<char>('0' + (_value % 10U));
+			_value /= 10U;
+		}
+		while (_value != 0U || count < _width);
+		
+		while (count > 0U) {
+			*_out++ = digits[--count];
+		}
+		
+		return _out;
+	}
+	
+	/** @brief Writes the symbol as a CSV field, quoting it if it holds a separator or a quote. */
+	char* WriteField(char* _out, const std::string& _symbol) noexcept {
+		
+		if (_symbol.find_first_of(",\"\r\n") == std::string::npos) {
+			
+			std::memcpy(_out, _symbol.data(), _symbol.size());
+			
+			return _out + _symbol.size();
+		}
+		
+		*_out++ = '"';
+		
+		for (const auto& c : _symbol) {
+			
+			if (c == '"') {
+				*_out++ = '"';
+			}
+			
+			*_out++ = c;
+		}
+		
+		*_out++ = '"';
+		
+		return _out;
+	}
+	
+	/**
+	 * @brief Writes a reading of six to nine significant figures with up to nine decimal places, some negative, some
+	 * integral, and some missing.
+	 */
+	char* WriteValue(char* _out, Random& _random) noexcept {
+		
+		const auto kind = _random.Below(200U);
+		
+		if (kind == 0U) {
+			return _out;
+		}
+		
+		if (kind < 12U) {
+			*_out++ = '-';
+		}
+		
+		static constexpr std::array<uint64_t, 10U> s_Powers { 1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U };
+		
+		const auto digits   = 6U + _random.Below(4U);
+		const auto decimals = kind < 30U ? 0U : _random.Below(digits);
+		
+		const auto mantissa = s_Powers[digits - 1U] + (_random.Next() % (s_Powers[digits - 1U] * 9U));
+		
+		// Shift the decimal point to spread the values over the orders of magnitude.
+		const auto shift = std::min(digits, decimals + _random.Below(3U));
+		
+		_out = Write(_out, mantissa / s_Powers[shift]);
+		
+		if (shift > 0U) {
+			*_out++ = '.';
+			_out = Write(_out, mantissa % s_Powers[shift], shift);
+		}
+		
+		return _out;
+	}
+	
+	/** @brief Parses a size such as "64K", "512M" or "20G". */
+	uint64_t ParseSize(const std::string& _text) {
+		
+		size_t end;
+		
+		auto result = static_cast<uint64_t>(std::stoull(_text, &end));
+		
+		if (end + 1U == _text.size()) {
+			
+			switch (_text[end]) {
+				case 'k': case 'K': { result <<= 10U; break; }
+				case 'm': case 'M': { result <<= 20U; break; }
+				case 'g': case 'G': { result <<= 30U; break; }
+				default: {
+					throw std::runtime_error("Unrecognised size suffix in \"" + _text + "\".");
+				}
+			}
+		}
+		else if (end != _text.size()) {
+			throw std::runtime_error("Invalid size \"" + _text + "\".");
+		}
+		
+		return result;
+	}
+	
+	Options ParseOptions(const int& _argc, char* _argv[]) {
+		
+		Options result;
+		
+		const std::string kind(_argv[1]);
+		
+		if (kind != "csv" && kind != "symbols") {
+			throw std::runtime_error("Unrecognised kind \"" + kind + "\"; expected \"csv\" or \"symbols\".");
+		}
+		
+		result.m_CSV  = kind == "csv";
+		result.m_Size = ParseSize(_argv[2]);
+		
+		for (auto i = 3; i < _argc; ++i) {
+			
+			const std::string argument(_argv[i]);
+			
+			const auto equals = argument.find('=');
+			const auto name   = argument.substr(0U, equals);
+			const auto value  = equals == std::string::npos ? std::string() : argument.substr(equals + 1U);
+			
+			if      (name == "--seed")      { result.m_Seed      = std::stoull(value); }
+			else if (name == "--variants")  { result.m_Variants  = std::stod(value);   }
+			else if (name == "--typos")     { result.m_Typos     = std::stod(value);   }
+			else if (name == "--dimension") { result.m_Dimension = value;              }
+			else if (name == "--output")    { result.m_Output    = value;              }
+			else {
+				throw std::runtime_error("Unrecognised option \"" + argument + "\".");
+			}
+		}
+		
+		return result;
+	}
+	
+	/** @brief Buffers output and writes it in large blocks. */
+	struct Writer final {
+		
+		std::FILE* m_File;
+		
+		std::vector<char> m_Buffer = std::vector<char>(1U << 20U);
+		
+		size_t m_Used { 0U };
+		
+		void Append(const char* _data, const size_t& _size) {
+			
+			if (m_Used + _size > m_Buffer.size()) {
+				Flush();
+			}
+			
+			std::memcpy(m_Buffer.data() + m_Used, _data, _size);
+			m_Used += _size;
+		}
+		
+		void Flush() {
+			
+			if (std::fwrite(m_Buffer.data(), 1U, m_Used, m_File) != m_Used) {
+				throw std::runtime_error("Failed to write output.");
+			}
+			
+			m_Used = 0U;
+		}
+	};
+	
+	/** @brief Returns the number of lines written. */
+	uint64_t Generate(const Options& _options, Writer& _writer) {
+		
+		Random random { _options.m_Seed };
+		
+		std::vector<std::string> aliases;
+		
+		Collect<Conversions::Speed>      (_options.m_Dimension, aliases);
+		Collect<Conversions::Distance>   (_options.m_Dimension, aliases);
+		Collect<Conversions::Rotation>   (_options.m_Dimension, aliases);
+		Collect<Conversions::Time>       (_options.m_Dimension, aliases);
+		Collect<Conversions::Temperature>(_options.m_Dimension, aliases);
+		Collect<Conversions::Pressure>   (_options.m_Dimension, aliases);
+		Collect<Conversions::Mass>       (_options.m_Dimension, aliases);
+		Collect<Conversions::Area>       (_options.m_Dimension, aliases);
+		Collect<Conversions::Volume>     (_options.m_Dimension, aliases);
+		
+		const Zipf zipf(std::move(aliases), random);
+		
+		uint64_t written = 0U;
+		uint64_t lines   = 0U;
+		
+		const auto emit = [&](const char* _line, const size_t& _size) {
+			
+			if (written + _size > _options.m_Size) {
+				return false;
+			}
+			
+			_writer.Append(_line, _size);
+			written += _size;
+			++lines;
+			
+			return true;
+		};
+		
+		if (_options.m_CSV) {
+			
+			static constexpr std::string_view s_Header = "timestamp,sensor,value,unit\n";
+			
+			if (!emit(s_Header.data(), s_Header.size())) {
+				return 0U;
+			}
+		}
+		
+		// Milliseconds since the epoch, from 2026-01-01.
+		uint64_t timestamp = 1767225600000U;
+		
+		std::string symbol;
+		
+		for (char line[256];;) {
+			
+			symbol = zipf(random);
+			
+			if (random.Chance(_options.m_Variants)) { Vary(symbol, random); }
+			if (random.Chance(_options.m_Typos))    { Typo(symbol, random); }
+			
+			auto* out = line;
+			
+			if (_options.m_CSV) {
+				
+				timestamp += random.Below(1000U);
+				
+				out = Write(out, timestamp);
+				std::memcpy(out, ",s", 2U);
+				out = Write(out + 2U, random.Below(10000U), 4U);
+				*out++ = ',';
+				out = WriteValue(out, random);
+				*out++ = ',';
+				out = WriteField(out, symbol);
+			}
+			else {
+				std::memcpy(out, symbol.data(), symbol.size());
+				out += symbol.size();
+			}
+			
+			*out++ = '\n';
+			
+			if (!emit(line, static_cast<size_t>(out - line))) {
+				break;
+			}
+		}
+		
+		return lines;
+	}
+	
+} // namespace
+
+int main(int _argc, char* _argv[]) {
+	
+	if (_argc < 3) {
+		std::fprintf(stderr, "Usage: %s <csv|symbols> <size> [--seed=N] [--variants=P] [--typos=P] [--dimension=NAME] [--output=PATH]\n", _argv[0]);
+		return 1;
+	}
+	
+	try {
+		
+		const auto options = ParseOptions(_argc, _argv);
+		
+		Writer writer { options.m_Output.empty() ? stdout : std::fopen(options.m_Output.c_str(), "wb") };
+		
+		if (writer.m_File == nullptr) {
+			throw std::runtime_error("Could not open \"" + options.m_Output + "\" for writing.");
+		}
+		
+		const auto lines = Generate(options, writer);
+		
+		writer.Flush();
+		
+		if (writer.m_File != stdout && std::fclose(writer.m_File) != 0) {
+			throw std::runtime_error("Failed to write output.");
+		}
+		
+		std::fprintf(stderr, "Generated %llu line(s).\n", static_cast<unsigned long long>(lines));
+	}
+	catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+	
+	return 0;
+}
@@ -0,0 +1,307 @@
+/*
+ * Checks that conversions are bit-identical across code paths, thread counts and builds in the reproducibility
+ * mode (LOUIERIKSSON_MATHS_REPRODUCIBLE).
+ *
+ * Every pair of units of every dimension converts the same seeded values (including signed zeros, subnormals and
+ * extremes) through the scalar Plan, which is the reference, and through each batch kernel: the dictionary and
+ * packed unit columns, ParseColumn, Arrow, and Convert of the linear dimensions. The dictionary kernel is also run
+ * split between 1 to 8 threads at unaligned boundaries. Any result whose bits differ from the reference is
+ * reported, and the program fails.
+ *
+ * It then prints a digest of every result, including those of Velocity and DMS. The digest must be identical
+ * between builds for different targets, which exercises the scalar, SSE, AVX2 and AVX-512 paths and the presence or
+ * absence of FMA:
+ *
+ *   for flags in "-O0" "-O3 -march=x86-64" "-O3 -mavx2 -mfma" "-O3 -march=skylake-avx512"; do
+ *       g++ -std=c++17 $flags -ffp-contract=fast -DLOUIERIKSSON_MATHS_REPRODUCIBLE -I.. -I<cpp-hashmap> \
+ *           Reproducibility.cpp -o reproducibility -pthread && ./reproducibility
+ *   done
+ *
+ * -ffp-contract=fast is GCC's default, and is given explicitly as the worst case.
+ */
+
+#ifndef LOUIERIKSSON_MATHS_REPRODUCIBLE
+	#error "Build with -DLOUIERIKSSON_MATHS_REPRODUCIBLE."
+#endif
+
+#include "../Arrow.hpp"
+#include "../Columns.hpp"
+#include "../Conversions.hpp"
+#include "../DMS.hpp"
+#include "../Expressions.hpp"
+#include "../Parsing.hpp"
+#include "../Velocity.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	
+	using LouiEriksson::Maths::Conversions;
+	
+	/** @brief Accumulates the bits of every result into an FNV-1a digest. */
+	struct Digest final {
+		
+		uint64_t m_Value { 0xCBF29CE484222325ULL };
+		
+		void Add(const double* _values, const size_t& _size) noexcept {
+			
+			for (size_t i = 0U; i < _size; ++i) {
+				
+				uint64_t bits;
+				std::memcpy(&bits, &_values[i], sizeof(bits));
+				
+				for (size_t k = 0U; k < 8U; ++k) {
+					m_Value = (m_Value ^ ((bits >> (k * 8U)) & 0xFFU)) * 0x100000001B3ULL;
+				}
+			}
+		}
+	};
+	
+	size_t s_Failures = 0U;
+	
+	/** @brief Reports the first value whose bits differ from the reference. */
+	void Compare(const char* _kernel, const char* _dimension, const size_t& _from, const size_t& _to, const std::vector<double>& _expected, const std::vector<double>& _actual) {
+		
+		for (size_t i = 0U; i < _expected.size(); ++i) {
+			
+			if (std::memcmp(&_expected[i], &_actual[i], sizeof(double)) != 0) {
+				
+				std::printf("%s differs for %s %zu -> %zu at %zu: %a != %a\n", _kernel, _dimension, _from, _to, i, _actual[i], _expected[i]);
+				
+				++s_Failures;
+				
+				return;
+			}
+		}
+	}
+	
+	/**
+	 * @brief Returns a symbol which TryGuessUnit resolves to a unit.
+	 *
+	 * @note TDimension::Symbol is not always one (such as "C" for Celsius).
+	 */
+	template<typename TDimension>
+	std::string Alias(const typename TDimension::Unit& _unit) {
+		
+		for (const auto& alias : TDimension::Aliases()) {
+			
+			if (alias.second == _unit) {
+				return alias.first;
+			}
+		}
+		
+		return TDimension::Symbol(_unit);
+	}
+	
+	/** @brief Encodes a single key-value pair as Arrow schema metadata. */
+	std::string Metadata(const std::string_view& _key, const std::string& _value) {
+		
+		std::string result;
+		
+		const auto append = [&](const int32_t& _int) { result.append(reinterpret_cast<const char*>(&_int), sizeof(_int)); };
+		
+		append(1);
+		append(static_cast<int32_t>(_key.size()));
+		result.append(_key);
+		append(static_cast<int32_t>(_value.size()));
+		result.append(_value);
+		
+		return result;
+	}
+	
+	std::vector<double> GenerateValues(const size_t& _size, const uint32_t& _seed) {
+		
+		std::vector<double> result {
+			0.0, -0.0, 1.0, -1.0,
+			std::numeric_limits<double>::min(),
+			std::numeric_limits<double>::denorm_min(),
+			-std::numeric_limits<double>::denorm_min(),
+			std::numeric_limits<double>::max(),
+			-std::numeric_limits<double>::max(),
+			std::numeric_limits<double>::infinity(),
+		};
+		
+		std::mt19937_64 rng(_seed);
+		
+		std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+		std::uniform_int_distribution<int>     exponent(-40, 40);
+		
+		while (result.size() < _size) {
+			result.emplace_back(std::ldexp(mantissa(rng), exponent(rng)));
+		}
+		
+		return result;
+	}
+	
+	template<typename TDimension>
+	void Check(const std::vector<double>& _values, Digest& _digest) {
+		
+		const auto* const name = Conversions::Name<TDimension>();
+		
+		const auto size = _values.size();
+		
+		std::vector<double> expected(size), actual(size);
+		
+		// ParseColumn reads the values back from text, which round-trips exactly at 17 significant digits.
+		std::string text;
+		
+		for (const auto& value : _values) {
+			
+			char buffer[32];
+			std::snprintf(buffer, sizeof(buffer), "%.17g,", value);
+			
+			text += buffer;
+		}
+		
+		for (size_t from = 0U; from < TDimension::s_Count; ++from) {
+			
+			const auto from_unit = static_cast<typename TDimension::Unit>(from);
+			
+			LouiEriksson::Maths::PackedUnitColumn<TDimension> packed;
+			
+			for (size_t i = 0U; i < size; ++i) {
+				packed.Push(from_unit);
+			}
+			
+			const std::vector<uint8_t> codes(size, 0U);
+			
+			for (size_t to = 0U; to < TDimension::s_Count; ++to) {
+				
+				const auto to_unit = static_cast<typename TDimension::Unit>(to);
+				const auto plan    = Conversions::Plan::Make<TDimension>(from_unit, to_unit);
+				
+				for (size_t i = 0U; i < size; ++i) {
+					expected[i] = plan(_values[i]);
+				}
+				
+				_digest.Add(expected.data(), size);
+				
+				const LouiEriksson::Maths::UnitDictionary<TDimension> dictionary({ Alias<TDimension>(from_unit) }, to_unit);
+				
+				dictionary.Convert(_values.data(), codes.data(), size, actual.data());
+				Compare("UnitDictionary", name, from, to, expected, actual);
+				
+				// Split between threads at boundaries which are not multiples of any vector width.
+				for (size_t threads = 2U; threads <= 8U; ++threads) {
+					
+					std::fill(actual.begin(), actual.end(), 0.0);
+					
+					std::vector<std::thread> workers;
+					
+					const auto chunk = (size / threads) | 1U;
+					
+					for (size_t begin = 0U; begin < size; begin += chunk) {
+						
+						const auto count = std::min(chunk, size - begin);
+						
+						workers.emplace_back([&, begin, count]() {
+							dictionary.Convert(_values.data() + begin, codes.data() + begin, count, actual.data() + begin);
+						});
+					}
+					
+					for (auto& worker : workers) {
+						worker.join();
+					}
+					
+					Compare("UnitDictionary (threaded)", name, from, to, expected, actual);
+				}
+				
+				packed.Convert(_values.data(), to_unit, actual.data());
+				Compare("PackedUnitColumn", name, from, to, expected, actual);
+				
+				std::fill(actual.begin(), actual.end(), 0.0);
+				LouiEriksson::Maths::Parsing::ParseColumn(text, ',', plan, actual.data(), size);
+				Compare("ParseColumn", name, from, to, expected, actual);
+				
+				if constexpr (!std::is_same_v<TDimension, Conversions::Temperature>) {
+					
+					for (size_t i = 0U; i < size; ++i) {
+						actual[i] = TDimension::Convert(_values[i], from_unit, to_unit);
+					}
+					
+					Compare("Convert", name, from, to, expected, actual);
+					
+					const LouiEriksson::Maths::Expressions::Array<TDimension> array(_values.data(), size, from_unit);
+					
+					LouiEriksson::Maths::Expressions::Evaluate(array, to_unit, actual.data());
+					Compare("Expressions", name, from, to, expected, actual);
+				}
+				
+				const auto metadata = Metadata(LouiEriksson::Maths::Arrow::s_UnitKey, Alias<TDimension>(from_unit));
+				
+				ArrowSchema schema{};
+				schema.format   = "g";
+				schema.metadata = metadata.data();
+				
+				const void* buffers[2] { nullptr, _values.data() };
+				
+				ArrowArray array{};
+				array.length    = static_cast<int64_t>(size);
+				array.n_buffers = 2;
+				array.buffers   = buffers;
+				
+				std::fill(actual.begin(), actual.end(), 0.0);
+				LouiEriksson::Maths::Arrow::Convert<TDimension>(schema, array, to_unit, actual.data());
+				Compare("Arrow", name, from, to, expected, actual);
+			}
+		}
+	}
+	
+} // namespace
+
+int main() {
+	
+	const auto values = GenerateValues(1021U, 42U);
+	
+	Digest digest;
+	
+	Check<Conversions::Speed>      (values, digest);
+	Check<Conversions::Distance>   (values, digest);
+	Check<Conversions::Rotation>   (values, digest);
+	Check<Conversions::Time>       (values, digest);
+	Check<Conversions::Temperature>(values, digest);
+	Check<Conversions::Pressure>   (values, digest);
+	Check<Conversions::Mass>       (values, digest);
+	Check<Conversions::Area>       (values, digest);
+	Check<Conversions::Volume>     (values, digest);
+	
+	// Kernels without a scalar reference contribute only to the digest.
+	{
+		std::vector<double> out(values.size());
+		
+		LouiEriksson::Maths::Velocity::Magnitude(values.data(), values.data() + 1U, values.data() + 2U, values.size() - 2U, Conversions::Speed::MetreSecond, Conversions::Speed::Knot, out.data());
+		digest.Add(out.data(), values.size() - 2U);
+		
+		std::vector<double> degrees(values.size()), minutes(values.size()), seconds(values.size());
+		
+		LouiEriksson::Maths::DMS::FromUnit(values.data(), values.size(), Conversions::Rotation::Radian, degrees.data(), minutes.data(), seconds.data());
+		digest.Add(degrees.data(), values.size());
+		digest.Add(minutes.data(), values.size());
+		digest.Add(seconds.data(), values.size());
+		
+		LouiEriksson::Maths::DMS::ToUnit(degrees.data(), minutes.data(), seconds.data(), values.size(), Conversions::Rotation::Gradian, out.data());
+		digest.Add(out.data(), values.size());
+	}
+	
+	std::printf("Digest: %016" PRIX64 "\n", digest.m_Value);
+	
+	if (s_Failures != 0U) {
+		std::printf("%zu kernels differ from the reference.\n", s_Failures);
+		return 1;
+	}
+	
+	return 0;
+}
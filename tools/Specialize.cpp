@@ -0,0 +1,340 @@
+/*
+ * Generates a header of specialised conversion kernels for the unit pairs which dominate a workload.
+ *
+ * The profile is a text file of conversion counts, one (dimension, from, to) pair per line, for example as
+ * exported from instrumentation counters:
+ *
+ *   # dimension, from, to, count
+ *   Pressure, psi,  kPa, 48211734
+ *   Speed,    km/h, m/s, 30117263
+ *
+ * Dimensions are named as in Conversions, and units by any symbol their TryGuessUnit recognises. Counts of
+ * repeated pairs are summed. The top N pairs are emitted as kernels with their factor (and offset) as literal
+ * constants, behind a switch which falls back to the generic Plan for every other pair:
+ *
+ *   LouiEriksson::Maths::Specialized::Convert<Conversions::Pressure>(in, out, size, from, to);
+ *
+ * Build (the include paths being this repository and cpp-hashmap), and run as part of the build:
+ *
+ *   g++ -std=c++17 -O2 -I.. -I<cpp-hashmap> Specialize.cpp -o specialize
+ *   ./specialize profile.csv Specialized.hpp [top-n]
+ */
+
+#include "../Conversions.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	
+	using LouiEriksson::Maths::Conversions;
+	
+	/** @brief A resolved (dimension, from, to) pair. */
+	struct Pair final {
+		
+		std::string m_Dimension;
+		
+		unsigned m_From;
+		unsigned m_To;
+		
+		std::string m_FromSymbol;
+		std::string m_ToSymbol;
+		
+		Conversions::Plan m_Plan;
+		
+		uint64_t m_Count;
+	};
+	
+	std::string Trim(const std::string& _text) {
+		
+		const auto first = _text.find_first_not_of(" \t\r");
+		const auto last  = _text.find_last_not_of(" \t\r");
+		
+		return first == std::string::npos ? std::string() : _text.substr(first, (last - first) + 1U);
+	}
+	
+	template<typename TDimension>
+	std::optional<Pair> Resolve(const std::string& _dimension, const std::string& _from, const std::string& _to) {
+		
+		const auto from = TDimension::TryGuessUnit(_from);
+		const auto to   = TDimension::TryGuessUnit(_to);
+		
+		if (!from.has_value() || !to.has_value()) {
+			return std::nullopt;
+		}
+		
+		return Pair {
+			_dimension,
+			static_cast<unsigned>(from.value().get()),
+			static_cast<unsigned>(to.value().get()),
+			_from,
+			_to,
+			Conversions::Plan::Make<TDimension>(from.value(), to.value()),
+			0U
+		};
+	}
+	
+	std::optional<Pair> Resolve(const std::string& _dimension, const std::string& _from, const std::string& _to) {
+		
+		if (_dimension == Conversions::Name<Conversions::Speed>())       { return Resolve<Conversions::Speed>      (_dimension, _from, _to); }
+		if (_dimension == Conversions::Name<Conversions::Distance>())    { return Resolve<Conversions::Distance>   (_dimension, _from, _to); }
+		if (_dimension == Conversions::Name<Conversions::Rotation>())    { return Resolve<Conversions::Rotation>   (_dimension, _from, _to); }
+		if (_dimension == Conversions::Name<Conversions::Time>())        { return Resolve<Conversions::Time>       (_dimension, _from, _to); }
+		if (_dimension == Conversions::Name<Conversions::Temperature>()) { return Resolve<Conversions::Temperature>(_dimension, _from, _to); }
+		if (_dimension == Conversions::Name<Conversions::Pressure>())    { return Resolve<Conversions::Pressure>   (_dimension, _from, _to); }
+		if (_dimension == Conversions::Name<Conversions::Mass>())        { return Resolve<Conversions::Mass>       (_dimension, _from, _to); }
+		if (_dimension == Conversions::Name<Conversions::Area>())        { return Resolve<Conversions::Area>       (_dimension, _from, _to); }
+		if (_dimension == Conversions::Name<Conversions::Volume>())      { return Resolve<Conversions::Volume>     (_dimension, _from, _to); }
+		
+		throw std::runtime_error("Unknown dimension \"" + _dimension + "\".");
+	}
+	
+	std::vector<Pair> ReadProfile(const std::string& _path) {
+		
+		std::ifstream file(_path);
+		
+		if (!file) {
+			throw std::runtime_error("Could not open \"" + _path + "\".");
+		}
+		
+		// Keyed by (dimension, from, to), so that aliases of the same units are summed.
+		std::map<std::tuple<std::string, unsigned, unsigned>, Pair> pairs;
+		
+		std::string line;
+		
+		for (size_t number = 1U; std::getline(file, line); ++number) {
+			
+			line = Trim(line.substr(0U, line.find('#')));
+			
+			if (line.empty()) {
+				continue;
+			}
+			
+			std::vector<std::string> fields;
+			
+			std::stringstream stream(line);
+			
+			for (std::string field; std::getline(stream, field, ',');) {
+				fields.emplace_back(Trim(field));
+			}
+			
+			if (fields.size() != 4U) {
+				throw std::runtime_error(_path + ":" + std::to_string(number) + ": expected \"dimension, from, to, count\".");
+			}
+			
+			auto pair = Resolve(fields[0], fields[1], fields[2]);
+			
+			if (!pair.has_value()) {
+				throw std::runtime_error(_path + ":" + std::to_string(number) + ": unrecognised unit.");
+			}
+			
+			const auto count = std::stoull(fields[3]);
+			
+			auto [iterator, inserted] = pairs.try_emplace({ pair->m_Dimension, pair->m_From, pair->m_To }, *pair);
+			
+			iterator->second.m_Count += count;
+		}
+		
+		std::vector<Pair> result;
+		
+		for (auto& [key, pair] : pairs) {
+			
+			// Identity conversions need no kernel.
+			if (pair.m_From != pair.m_To) {
+				result.emplace_back(std::move(pair));
+			}
+		}
+		
+		std::stable_sort(result.begin(), result.end(), [](const Pair& _lhs, const Pair& _rhs) {
+			return _lhs.m_Count > _rhs.m_Count;
+		});
+		
+		return result;
+	}
+	
+	std::string Literal(const Conversions::conversion_scalar_t& _value) {
+		
+		char buffer[64];
+		
+		// Written in the precision of conversion_scalar_t, which is double in the reproducibility mode.
+		if constexpr (std::is_same_v<Conversions::conversion_scalar_t, double>) {
+			std::snprintf(buffer, sizeof(buffer), "%.17g", static_cast<double>(_value));
+		}
+		else {
+			std::snprintf(buffer, sizeof(buffer), "%.21LgL", static_cast<long double>(_value));
+		}
+		
+		return buffer;
+	}
+	
+	void Write(std::ostream& _out, const std::vector<Pair>& _pairs) {
+		
+		_out <<
+			"/*\n"
+			" * Generated by tools/Specialize.cpp. Do not edit.\n"
+			" */\n"
+			"\n"
+			"#ifndef LOUIERIKSSON_SPECIALIZED_HPP\n"
+			"#define LOUIERIKSSON_SPECIALIZED_HPP\n"
+			"\n"
+			"#include \"Conversions.hpp\"\n"
+			"\n"
+			"#include <cstddef>\n"
+			"\n"
+			"namespace LouiEriksson::Maths::Specialized {\n"
+			"\t\n"
+			"\t/** @brief The specialised kernels of a dimension. Dimensions without any have none. */\n"
+			"\ttemplate<typename TDimension>\n"
+			"\tstruct Kernels final {\n"
+			"\t\t\n"
+			"\t\ttemplate<typename T>\n"
+			"\t\tstatic bool TryConvert(const T* /*_in*/, T* /*_out*/, const size_t& /*_size*/, const typename TDimension::Unit& /*_from*/, const typename TDimension::Unit& /*_to*/) noexcept {\n"
+			"\t\t\treturn false;\n"
+			"\t\t}\n"
+			"\t};\n";
+		
+		// Group the pairs by dimension, in order of their hottest pair.
+		std::vector<std::string> dimensions;
+		
+		for (const auto& pair : _pairs) {
+			
+			if (std::find(dimensions.begin(), dimensions.end(), pair.m_Dimension) == dimensions.end()) {
+				dimensions.emplace_back(pair.m_Dimension);
+			}
+		}
+		
+		for (const auto& dimension : dimensions) {
+			
+			const auto type = "Conversions::" + dimension;
+			
+			_out <<
+				"\t\n"
+				"\ttemplate<>\n"
+				"\tstruct Kernels<" << type << "> final {\n"
+				"\t\t\n"
+				"\t\ttemplate<typename T>\n"
+				"\t\tstatic bool TryConvert(const T* _in, T* _out, const size_t& _size, const " << type << "::Unit& _from, const " << type << "::Unit& _to) noexcept {\n"
+				"\t\t\t\n"
+				"\t\t\tswitch ((static_cast<unsigned>(_from) << 8U) | static_cast<unsigned>(_to)) {\n";
+			
+			for (const auto& pair : _pairs) {
+				
+				if (pair.m_Dimension != dimension) {
+					continue;
+				}
+				
+				_out <<
+					"\t\t\t\tcase (" << pair.m_From << "U << 8U) | " << pair.m_To << "U: { // " << pair.m_FromSymbol << " -> " << pair.m_ToSymbol << " (" << pair.m_Count << ")\n"
+					"\t\t\t\t\tfor (size_t i = 0U; i < _size; ++i) {\n";
+				
+				if (pair.m_Plan.IsLinear()) {
+					_out << "\t\t\t\t\t\t_out[i] = _in[i] * static_cast<T>(" << Literal(pair.m_Plan.m_Scale) << ");\n";
+				}
+				else {
+					_out <<
+						"\t\t\t\t\t\tauto product = _in[i] * static_cast<T>(" << Literal(pair.m_Plan.m_Scale) << ");\n"
+						"\t\t\t\t\t\tConversions::Round(product);\n"
+						"\t\t\t\t\t\t_out[i] = product + static_cast<T>(" << Literal(pair.m_Plan.m_Offset) << ");\n";
+				}
+				
+				_out <<
+					"\t\t\t\t\t}\n"
+					"\t\t\t\t\treturn true;\n"
+					"\t\t\t\t}\n";
+			}
+			
+			_out <<
+				"\t\t\t\tdefault: {\n"
+				"\t\t\t\t\treturn false;\n"
+				"\t\t\t\t}\n"
+				"\t\t\t}\n"
+				"\t\t}\n"
+				"\t};\n";
+		}
+		
+		_out <<
+			"\t\n"
+			"\t/**\n"
+			"\t * @brief Converts an array, with a specialised kernel if one was generated for the pair of units, and\n"
+			"\t * otherwise with the generic Plan.\n"
+			"\t *\n"
+			"\t * @param[in] _in Pointer to the first value.\n"
+			"\t * @param[out] _out Destination for the converted values. May be the same as _in.\n"
+			"\t * @param[in] _size The number of values.\n"
+			"\t * @param[in] _from The unit of the values.\n"
+			"\t * @param[in] _to The unit to convert to.\n"
+			"\t */\n"
+			"\ttemplate<typename TDimension, typename T>\n"
+			"\tinline void Convert(const T* _in, T* _out, const size_t& _size, const typename TDimension::Unit& _from, const typename TDimension::Unit& _to) {\n"
+			"\t\t\n"
+			"\t\tif (!Kernels<TDimension>::TryConvert(_in, _out, _size, _from, _to)) {\n"
+			"\t\t\t\n"
+			"\t\t\tconst auto plan = Conversions::Plan::Make<TDimension>(_from, _to);\n"
+			"\t\t\t\n"
+			"\t\t\tconst auto scale  = static_cast<T>(plan.m_Scale);\n"
+			"\t\t\tconst auto offset = plan.template Offset<T>();\n"
+			"\t\t\t\n"
+			"\t\t\tfor (size_t i = 0U; i < _size; ++i) {\n"
+			"\t\t\t\t\n"
+			"\t\t\t\tauto product = _in[i] * scale;\n"
+			"\t\t\t\tConversions::Round(product);\n"
+			"\t\t\t\t\n"
+			"\t\t\t\t_out[i] = product + offset;\n"
+			"\t\t\t}\n"
+			"\t\t}\n"
+			"\t}\n"
+			"\t\n"
+			"} // LouiEriksson::Maths::Specialized\n"
+			"\n"
+			"#endif //LOUIERIKSSON_SPECIALIZED_HPP\n";
+	}
+	
+} // namespace
+
+int main(int _argc, char* _argv[]) {
+	
+	if (_argc < 3 || _argc > 4) {
+		std::cerr << "Usage: " << _argv[0] << " <profile> <output> [top-n]\n";
+		return 1;
+	}
+	
+	try {
+		
+		const size_t top = _argc == 4 ? static_cast<size_t>(std::stoul(_argv[3])) : 5U;
+		
+		auto pairs = ReadProfile(_argv[1]);
+		
+		if (pairs.size() > top) {
+			pairs.resize(top);
+		}
+		
+		std::ofstream out(_argv[2], std::ios::trunc);
+		
+		if (!out) {
+			throw std::runtime_error("Could not open \"" + std::string(_argv[2]) + "\" for writing.");
+		}
+		
+		Write(out, pairs);
+		
+		std::cout << "Specialised " << pairs.size() << " unit pair(s) into \"" << _argv[2] << "\".\n";
+	}
+	catch (const std::exception& e) {
+		std::cerr << e.what() << '\n';
+		return 1;
+	}
+	
+	return 0;
+}
@@ -0,0 +1,196 @@
+/*
+ * Measures the cost of scanning free text for unit symbols, with and without SymbolFilter as a negative
+ * pre-check before TryGuessUnit.
+ *
+ * The text is synthetic but shaped like real logs: timestamped lines from a handful of services, mixing
+ * identifiers, key=value pairs, numbers, prose, and occasional readings with units. It is generated from a fixed
+ * seed, so results are comparable between runs.
+ *
+ * Build and run (the include paths being this repository and cpp-hashmap):
+ *
+ *   g++ -std=c++17 -O2 -I.. -I<cpp-hashmap> SymbolFilterBenchmark.cpp -o symbol-filter-benchmark
+ *   ./symbol-filter-benchmark [lines]
+ */
+
+#include "../SymbolFilter.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	
+	using LouiEriksson::Maths::Conversions;
+	using LouiEriksson::Maths::SymbolFilter;
+	
+	std::string GenerateText(const size_t& _lines, const uint32_t& _seed) {
+		
+		static constexpr std::array<const char*, 24U> s_Words {
+			"request", "completed", "failed", "retrying", "connection", "timeout", "user", "session", "cache",
+			"miss", "hit", "upstream", "worker", "queue", "depth", "latency", "payload", "accepted", "rejected",
+			"the", "of", "for", "with", "after",
+		};
+		
+		static constexpr std::array<const char*, 6U> s_Services {
+			"gateway", "ingest", "billing", "telemetry", "scheduler", "auth",
+		};
+		
+		static constexpr std::array<const char*, 12U> s_Units {
+			"hPa", "km/h", "m/s", "°C", "psi", "kg", "ms", "mph", "kPa", "ft", "mbar", "K",
+		};
+		
+		std::mt19937 rng(_seed);
+		
+		std::string result;
+		
+		char buffer[256];
+		
+		for (size_t i = 0U; i < _lines; ++i) {
+			
+			std::snprintf(buffer, sizeof(buffer), "2026-03-14T%02u:%02u:%02u.%03uZ %s [%s] id=%08x ",
+				static_cast<unsigned>(rng() % 24U), static_cast<unsigned>(rng() % 60U), static_cast<unsigned>(rng() % 60U), static_cast<unsigned>(rng() % 1000U),
+				(rng() % 10U) == 0U ? "WARN" : "INFO",
+				s_Services[rng() % s_Services.size()],
+				static_cast<unsigned>(rng())
+			);
+			
+			result += buffer;
+			
+			for (auto words = 4U + (rng() % 10U); words > 0U; --words) {
+				
+				// Roughly one token in twenty is a reading with a unit.
+				switch (rng() % 20U) {
+					case 0U: {
+						std::snprintf(buffer, sizeof(buffer), "%.2f %s ", static_cast<double>(rng() % 100000U) / 100.0, s_Units[rng() % s_Units.size()]);
+						break;
+					}
+					case 1U:
+					case 2U: {
+						std::snprintf(buffer, sizeof(buffer), "%u ", static_cast<unsigned>(rng() % 100000U));
+						break;
+					}
+					default: {
+						std::snprintf(buffer, sizeof(buffer), "%s ", s_Words[rng() % s_Words.size()]);
+						break;
+					}
+				}
+				
+				result += buffer;
+			}
+			
+			result += '\n';
+		}
+		
+		return result;
+	}
+	
+	std::vector<std::string_view> Tokenise(const std::string_view& _text) {
+		
+		std::vector<std::string_view> result;
+		
+		size_t begin = 0U;
+		
+		for (size_t i = 0U; i <= _text.size(); ++i) {
+			
+			if (i == _text.size() || _text[i] == ' ' || _text[i] == '\n' || _text[i] == '=' || _text[i] == '[' || _text[i] == ']') {
+				
+				if (i > begin) {
+					result.emplace_back(_text.substr(begin, i - begin));
+				}
+				
+				begin = i + 1U;
+			}
+		}
+		
+		return result;
+	}
+	
+	/** @brief Looks a token up in every dimension, returning true if any recognises it. */
+	bool Lookup(const std::string_view& _token) {
+		
+		const std::string token(_token);
+		
+		return Conversions::Speed::TryGuessUnit(token).has_value()       ||
+		       Conversions::Distance::TryGuessUnit(token).has_value()    ||
+		       Conversions::Rotation::TryGuessUnit(token).has_value()    ||
+		       Conversions::Time::TryGuessUnit(token).has_value()        ||
+		       Conversions::Temperature::TryGuessUnit(token).has_value() ||
+		       Conversions::Pressure::TryGuessUnit(token).has_value()    ||
+		       Conversions::Mass::TryGuessUnit(token).has_value()        ||
+		       Conversions::Area::TryGuessUnit(token).has_value()        ||
+		       Conversions::Volume::TryGuessUnit(token).has_value();
+	}
+	
+	template<typename TFunction>
+	double Time(const TFunction& _function, size_t& _result) {
+		
+		const auto start = std::chrono::steady_clock::now();
+		
+		_result = _function();
+		
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+	
+} // namespace
+
+int main(int _argc, char* _argv[]) {
+	
+	const size_t lines = _argc > 1 ? static_cast<size_t>(std::stoul(_argv[1])) : 200000U;
+	
+	const auto text   = GenerateText(lines, 42U);
+	const auto tokens = Tokenise(text);
+	
+	const SymbolFilter filter;
+	
+	size_t unfiltered_hits{}, filtered_hits{}, passed{};
+	
+	const auto unfiltered = Time([&]() {
+		
+		size_t hits = 0U;
+		
+		for (const auto& token : tokens) {
+			hits += Lookup(token) ? 1U : 0U;
+		}
+		
+		return hits;
+		
+	}, unfiltered_hits);
+	
+	const auto filtered = Time([&]() {
+		
+		size_t hits = 0U;
+		
+		for (const auto& token : tokens) {
+			
+			if (filter.MayContain(token)) {
+				
+				++passed;
+				
+				hits += Lookup(token) ? 1U : 0U;
+			}
+		}
+		
+		return hits;
+		
+	}, filtered_hits);
+	
+	const auto count = static_cast<double>(tokens.size());
+	
+	std::printf("Tokens:               %zu (%zu units)\n", tokens.size(), unfiltered_hits);
+	std::printf("Filter size:          %zu bytes\n", filter.Bytes());
+	std::printf("Passed filter:        %zu (%zu false positives, %.3f%% of non-units)\n", passed, passed - filtered_hits, 100.0 * static_cast<double>(passed - filtered_hits) / static_cast<double>(tokens.size() - filtered_hits));
+	std::printf("Lookup only:          %.1f ns/token\n", unfiltered / count);
+	std::printf("Filter, then lookup:  %.1f ns/token\n", filtered / count);
+	
+	if (filtered_hits != unfiltered_hits) {
+		std::printf("Error: the filter rejected a known symbol.\n");
+		return 1;
+	}
+	
+	return 0;
+}